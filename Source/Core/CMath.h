@@ -1,14 +1,125 @@
 #pragma once
 
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace CMath
 {
-    struct Vect2
+    // Fixed point scalar (Q format) used by deterministic physics
+    // note: integer math give exact same result on every compiler/flags (no FMA contraction)
+    template<int FracBits>
+    struct Fixed
+    {
+        static_assert(FracBits > 0 && FracBits < 31, "FracBits must fit in 32 bit");
+        static constexpr std::int32_t one { 1 << FracBits };
+
+        std::int32_t raw;
+
+        // keep trivial to be copyable with memcpy
+        Fixed() = default;
+
+        // note: float conversion is only deterministic for compile time constants or loaded data
+        constexpr Fixed(float value) noexcept
+            : raw{ static_cast<std::int32_t>(value * one + (value < 0.f ? -0.5f : 0.5f)) } {}
+
+        template<typename I, typename = typename std::enable_if<std::is_integral<I>::value>::type>
+        constexpr Fixed(I value) noexcept
+            : raw{ static_cast<std::int32_t>(value) * one } {}
+
+        static constexpr Fixed fromRaw(std::int32_t value) noexcept
+        {
+            Fixed result{};
+            result.raw = value;
+            return result;
+        }
+
+        explicit constexpr operator float() const noexcept { return static_cast<float>(raw) / one; }
+
+        Fixed& operator+=(Fixed rhs) noexcept { raw += rhs.raw; return *this; }
+        Fixed& operator-=(Fixed rhs) noexcept { raw -= rhs.raw; return *this; }
+        Fixed& operator*=(Fixed rhs) noexcept { return *this = *this * rhs; }
+        Fixed& operator/=(Fixed rhs) noexcept { return *this = *this / rhs; }
+
+        friend constexpr Fixed operator-(Fixed a) noexcept { return fromRaw(-a.raw); }
+        friend constexpr Fixed operator+(Fixed a, Fixed b) noexcept { return fromRaw(a.raw + b.raw); }
+        friend constexpr Fixed operator-(Fixed a, Fixed b) noexcept { return fromRaw(a.raw - b.raw); }
+
+        // widen to 64 bit to keep precision before rescale
+        friend constexpr Fixed operator*(Fixed a, Fixed b) noexcept
+        {
+            return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(a.raw) * b.raw) >> FracBits));
+        }
+
+        friend constexpr Fixed operator/(Fixed a, Fixed b) noexcept
+        {
+            return fromRaw(static_cast<std::int32_t>((static_cast<std::int64_t>(a.raw) * one) / b.raw));
+        }
+
+        friend constexpr bool operator==(Fixed a, Fixed b) noexcept { return a.raw == b.raw; }
+        friend constexpr bool operator!=(Fixed a, Fixed b) noexcept { return a.raw != b.raw; }
+        friend constexpr bool operator<(Fixed a, Fixed b) noexcept { return a.raw < b.raw; }
+        friend constexpr bool operator>(Fixed a, Fixed b) noexcept { return a.raw > b.raw; }
+        friend constexpr bool operator<=(Fixed a, Fixed b) noexcept { return a.raw <= b.raw; }
+        friend constexpr bool operator>=(Fixed a, Fixed b) noexcept { return a.raw >= b.raw; }
+    };
+
+    // 16.16 -> enough range for screen space coordinates
+    using Fixed16 = Fixed<16>;
+
+    inline float abs(float value) noexcept { return std::abs(value); }
+
+    template<int FracBits> constexpr Fixed<FracBits> abs(Fixed<FracBits> value) noexcept
+    {
+        return value.raw < 0 ? -value : value;
+    }
+
+    // T define the scalar used by the math path (float or Fixed)
+    template<typename T>
+    struct TVect2
     {
-        float x,y;
+        T x, y;
+
+        TVect2& operator+=(const TVect2& rhs) noexcept { x += rhs.x; y += rhs.y; return *this; }
+        TVect2& operator-=(const TVect2& rhs) noexcept { x -= rhs.x; y -= rhs.y; return *this; }
+
+        friend TVect2 operator-(const TVect2& v) noexcept { return { -v.x, -v.y }; }
+        friend TVect2 operator+(const TVect2& a, const TVect2& b) noexcept { return { a.x + b.x, a.y + b.y }; }
+        friend TVect2 operator-(const TVect2& a, const TVect2& b) noexcept { return { a.x - b.x, a.y - b.y }; }
+        friend TVect2 operator*(const TVect2& v, T scalar) noexcept { return { v.x * scalar, v.y * scalar }; }
+        friend bool operator==(const TVect2& a, const TVect2& b) noexcept { return a.x == b.x && a.y == b.y; }
+        friend bool operator!=(const TVect2& a, const TVect2& b) noexcept { return !(a == b); }
     };
 
+    using Vect2 = TVect2<float>;
+
     template<class T1, class T2> bool isIntersecting(T1& mA, T2& mB) noexcept
     {
         return mA.right() >= mB.left() && mA.left() <= mB.right() && mA.bottom() >= mB.top() && mA.top() <= mB.bottom();
     }
+
+    // bitmaps: number of set bits, index of the lowest set bit (word must not be 0)
+    inline int popcount(std::uint64_t word) noexcept
+    {
+#ifdef _MSC_VER
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+    inline int lowestBit(std::uint64_t word) noexcept
+    {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
 }
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <array>
+#include <type_traits>
+#include <vector>
+
 namespace ECS
 {
     class Entity;
@@ -17,4 +21,85 @@ namespace Event
         virtual void execute(ECS::Entity &) = 0;
         virtual void undo() = 0;
     };
-}
\ No newline at end of file
+
+    // Per frame buffer of compact command records (no virtual, no allocation once warmed up)
+    // producers (input, AI, network) push, one system execute the whole batch
+    template<typename TRecord>
+    class CommandBuffer
+    {
+        static_assert(std::is_trivially_copyable<TRecord>::value, "command record must be POD");
+
+        std::vector<TRecord> _records;
+
+    public:
+        void push(const TRecord &record)
+        {
+            _records.push_back(record);
+        }
+
+        // executor(TRecord&) in emission order, then buffer is emptied
+        template<typename F>
+        void execute(F &&executor)
+        {
+            for (auto &record : _records)
+                executor(record);
+
+            _records.clear();
+        }
+
+        // visitor(TRecord&) on pending records, buffer is kept
+        template<typename F>
+        void forEach(F &&visitor)
+        {
+            for (auto &record : _records)
+                visitor(record);
+        }
+
+        bool empty() const noexcept { return _records.empty(); }
+        std::size_t size() const noexcept { return _records.size(); }
+        void clear() noexcept { _records.clear(); }
+    };
+
+    // Ring buffer keeping the last Capacity executed records
+    // note: oldest entry is overwritten when full
+    template<typename TRecord, std::size_t Capacity>
+    class UndoLog
+    {
+        static_assert(Capacity > 0, "UndoLog capacity must not be null");
+
+        std::array<TRecord, Capacity> _records;
+        std::size_t _next = 0;
+        std::size_t _size = 0;
+
+    public:
+        void push(const TRecord &record)
+        {
+            _records[_next] = record;
+            _next = (_next + 1) % Capacity;
+            if (_size < Capacity) ++_size;
+        }
+
+        // most recent first
+        bool pop(TRecord &record)
+        {
+            if (_size == 0) return false;
+
+            _next = (_next + Capacity - 1) % Capacity;
+            --_size;
+            record = _records[_next];
+            return true;
+        }
+
+        // visitor(TRecord&) on kept records, order unspecified
+        template<typename F>
+        void forEach(F &&visitor)
+        {
+            for (std::size_t i { 0 }; i < _size; ++i)
+                visitor(_records[(_next + Capacity - 1 - i) % Capacity]);
+        }
+
+        bool empty() const noexcept { return _size == 0; }
+        std::size_t size() const noexcept { return _size; }
+        void clear() noexcept { _next = 0; _size = 0; }
+    };
+}
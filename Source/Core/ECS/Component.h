@@ -1,21 +1,43 @@
 #pragma once
+#include <cstdint>
+#include "ECS.h"
 
 namespace ECS
 {   
     class Entity;
+    class ByteStream;
+
+    // change counter of a component: readers keep the last version they synced and skip when equal
+    // note: no changed set is kept by type, consumers (shape sync, HierarchySystem) compare the version
+    //       of each entity they visit -> a skip cost one compare, not zero
+    using Version = std::uint32_t;
+
     class Component
     {
     protected:
         Entity& _entity;
+        // note: start at 1, 0 is free for "never synced"
+        Version _version { 1 };
     
         Component(Entity& entity);
 
+        // every mutator (setters, mutable accessors, Load) must call it
+        void changed() noexcept { ++_version; }
+
     public:
         virtual ~Component() = default;
 
-        virtual void Init() {}
+        Version version() const noexcept { return _version; }
+
         /// TODO: migrate logic to dedicated systems
         virtual void Update(float) {}
         virtual void Draw() {}
+
+        // snapshot: write/read component state (must be symmetrical)
+        virtual void Save(ByteStream&) const {}
+        virtual void Load(ByteStream&) {}
+        // snapshot: entity references are saved as ordinals, resolved once every entity is loaded
+        // note: entities = alive entities in snapshot order
+        virtual void Link(const EntityList&) {}
     };
 }
\ No newline at end of file
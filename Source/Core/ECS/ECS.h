@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <iostream>
@@ -37,17 +38,18 @@ namespace ECS
     constexpr std::size_t maxSystems { 32 };
     using SystemBitset = std::bitset<maxSystems>;
     
+    // note: atomic -> first use of a type can happen concurrently in several worlds (threads)
     namespace Internal
     {
         inline ComponenID getUniqueComponentID() noexcept
         {
-            static ComponenID lastID{ 0u };
+            static std::atomic<ComponenID> lastID{ 0u };
             return lastID++;
         }
 
         inline SystemID getUniqueSystemID() noexcept
         {
-            static SystemID lastID { 0u };
+            static std::atomic<SystemID> lastID { 0u };
             return lastID++;
         }
     }
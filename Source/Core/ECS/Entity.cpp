@@ -2,9 +2,32 @@
 #include "Entity.h"
 #include "Component.h"
 #include "Manager.h"
+#include "Snapshot.h"
 
 namespace ECS 
 {
+    Entity::Entity(Manager& mManager) 
+        : _manager(mManager), _componentPools(mManager.componentPools()) {}
+
+    void Entity::reserveComponents(std::size_t count)
+    {
+        _components.reserve(count);
+        _componentTypes.reserve(count);
+    }
+
+    void Entity::destroy()
+    {
+        if (!alive) return;
+
+        alive = false;
+        _manager.entityDestroyed(*this);
+    }
+
+    void Entity::componentAdded(ComponenID id)
+    {
+        _manager.componentAdded(*this, id);
+    }
+
     void ECS::Entity::addGroup(Group mGroup) noexcept
     {
         _groupBitset[mGroup] = true;
@@ -32,4 +55,30 @@ namespace ECS
         _groupBitset[mGroup] = false;
     }
 
+    void Entity::SaveLayout(ByteStream& layout) const
+    {
+        layout.write(static_cast<std::uint32_t>(_groupBitset.to_ulong()));
+        layout.write(static_cast<std::uint8_t>(_componentTypes.size()));
+        for (auto id : _componentTypes)
+            layout.write(static_cast<std::uint8_t>(id));
+    }
+
+    void Entity::SaveState(ByteStream& state) const
+    {
+        for (auto &c : _components)
+            c->Save(state);
+    }
+
+    void Entity::LoadState(ByteStream& state)
+    {
+        for (auto &c : _components)
+            c->Load(state);
+    }
+
+    void Entity::Link(const EntityList& entities)
+    {
+        for (auto &c : _components)
+            c->Link(entities);
+    }
+
 } // namespace ECS
\ No newline at end of file
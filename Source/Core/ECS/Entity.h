@@ -7,19 +7,29 @@
 #include <cassert>
 #include "ECS.h"
 #include "Component.h"
+#include "Pool.h"
 
 namespace ECS
 {
     class Manager;
     class Component;
+    class ByteStream;
     
+    // component memory belong to the manager pools
+    using ComponentPtr = std::unique_ptr<Component, PoolDeleter<Component>>;
+
     class Entity
     {
     private:
         Manager &_manager;
+        ComponentPools &_componentPools;
         bool alive { true };
+        // rank among alive entities, set by the last manager save
+        std::uint32_t _ordinal { 0 };
         // warranty unique instance
-        std::vector<std::unique_ptr<Component>> _components;
+        std::vector<ComponentPtr> _components;
+        // component type IDs in insertion order (used by snapshot layout)
+        std::vector<ComponenID> _componentTypes;
     
         // keep a dictionary to quick access component
         ComponentArray _cachedComponents = {};
@@ -29,20 +39,40 @@ namespace ECS
     
         // used to define in which group Entity is registered
         GroupBitset _groupBitset;
+
+        // queue construct hooks of the component type (fired by manager refresh)
+        void componentAdded(ComponenID id);
     
     public:
-        Entity(Manager& mManager) : _manager(mManager) {}
+        Entity(Manager& mManager);
         void Update(float mFT);
         void Draw();
+
+        // snapshot
+        void SaveLayout(ByteStream& layout) const;
+        void SaveState(ByteStream& state) const;
+        void LoadState(ByteStream& state);
+        void Link(const EntityList& entities);
+
+        // reference to this entity in a snapshot (see Component::Link)
+        std::uint32_t ordinal() const noexcept { return _ordinal; }
+        void ordinal(std::uint32_t ordinal) noexcept { _ordinal = ordinal; }
     
+        // avoid reallocation when component count is known (bulk creation)
+        void reserveComponents(std::size_t count);
+
         bool isAlive() const { return alive; }
-        void destroy() { alive = false; }
+        // released by the next manager refresh
+        void destroy();
     
         template<typename T> bool hasComponent() const
         {
             return _componentBitset[getComponentTypeID<T>()];
         }
     
+        const std::vector<ComponenID>& componentTypes() const noexcept { return _componentTypes; }
+        const GroupBitset& groups() const noexcept { return _groupBitset; }
+
         bool hasGroup(Group mGroup) const noexcept
         {
             return _groupBitset[mGroup];
@@ -59,18 +89,20 @@ namespace ECS
             assert(!hasComponent<T>());
     
             // TODO: use DIP injection to automate entity reference
-            std::unique_ptr<T> componentPtr = std::make_unique<T>(std::forward<TArgs>(mArgs)...);
+            auto &pool(_componentPools.get<T>());
+            T* component { pool.create(std::forward<TArgs>(mArgs)...) };
+            ComponentPtr componentPtr { component, pool.deleter() };
     
             // register cache component for fast access
-            _cachedComponents[getComponentTypeID<T>()] = componentPtr.get();
+            _cachedComponents[getComponentTypeID<T>()] = component;
             _componentBitset[getComponentTypeID<T>()] = true;
-            componentPtr->Init();
+            componentAdded(getComponentTypeID<T>());
 
             // move is mandatory because unique_ptr cannot be copied
             _components.emplace_back(std::move(componentPtr));
-            componentPtr = nullptr;
+            _componentTypes.emplace_back(getComponentTypeID<T>());
             
-            return getComponent<T>();
+            return *component;
         }
 
         template<typename T>
@@ -1,6 +1,7 @@
 
 #include "Manager.h"
 
+#include <algorithm>
 #include "System.h"
 #include "Entity.h"
 
@@ -30,8 +31,38 @@ namespace ECS
         return _groupedEntities[group];
     }
 
+    void Manager::fireHooks(std::array<EntityList, maxComponents>& pending, const std::array<std::vector<ComponentHook>, maxComponents>& hooks)
+    {
+        for (auto id { 0u }; id < maxComponents; ++id)
+        {
+            if (pending[id].empty()) continue;
+
+            // note: swapped out -> entities created by a hook are queued for the next refresh
+            _hookBatch.swap(pending[id]);
+            for (auto &hook : hooks[id])
+                hook(_hookBatch);
+            _hookBatch.clear();
+        }
+    }
+
     void Manager::refresh()
     {
+        fireHooks(_constructed, _constructHooks);
+
+        // destroyed entities are gathered by hooked component type while still in memory
+        // note: loop -> entities destroyed by a destroy hook are reported before being released too
+        while (!_destroyedEntities.empty())
+        {
+            for (Entity* entity : _destroyedEntities)
+            {
+                for (auto id : entity->componentTypes())
+                    if (!_destroyHooks[id].empty())
+                        _destroyed[id].push_back(entity);
+            }
+            _destroyedEntities.clear();
+            fireHooks(_destroyed, _destroyHooks);
+        }
+
         // remove from group first
         for (auto i { 0u }; i < maxGroups; ++i)
         {
@@ -54,7 +85,7 @@ namespace ECS
         // Note: remove_if sort list and push all destroyed brick at the end of the list
         _entities.erase(
             remove_if(begin(_entities), end(_entities),
-                [] (const std::unique_ptr<Entity> &mEntity) {
+                [] (const EntityPtr &mEntity) {
             return !mEntity->isAlive();
         }),
             end(_entities));
@@ -62,10 +93,154 @@ namespace ECS
 
     ECS::Entity & Manager::addEntity()
     {
-        std::unique_ptr<Entity> entityPtr = std::make_unique<Entity>(*this);
+        EntityPtr entityPtr { _entityPool.create(*this), _entityPool.deleter() };
         ECS::Entity& entity = *entityPtr.get();
         _entities.emplace_back(std::move(entityPtr));
 
         return entity;
     }
+
+    void Manager::reserveEntities(std::size_t count)
+    {
+        _entities.reserve(_entities.size() + count);
+    }
+
+    void Manager::reserveGroup(Group group, std::size_t count)
+    {
+        auto &v(_groupedEntities[group]);
+        v.reserve(v.size() + count);
+    }
+
+    void Manager::save(Snapshot& snapshot) const
+    {
+        snapshot.layout.clear();
+        snapshot.state.clear();
+
+        // note: ordinals first -> a component can reference an entity saved after it
+        std::uint32_t ordinal { 0 };
+        for (auto &e : _entities)
+        {
+            if (e->isAlive())
+                e->ordinal(ordinal++);
+        }
+
+        for (auto &e : _entities)
+        {
+            if (!e->isAlive()) continue;
+
+            e->SaveLayout(snapshot.layout);
+            e->SaveState(snapshot.state);
+        }
+    }
+
+    void Manager::restore(Snapshot& snapshot)
+    {
+        _layoutScratch.clear();
+        for (auto &e : _entities)
+        {
+            if (e->isAlive()) 
+                e->SaveLayout(_layoutScratch);
+        }
+
+        snapshot.state.rewind();
+
+        // same entities -> only copy back component state
+        if (_layoutScratch == snapshot.layout)
+        {
+            for (auto &e : _entities)
+            {
+                if (e->isAlive())
+                    e->LoadState(snapshot.state);
+            }
+            link();
+            return;
+        }
+
+        rebuild(snapshot);
+    }
+
+    void Manager::rebuild(Snapshot& snapshot)
+    {
+        // current entities leave through refresh -> destroy hooks see them
+        for (auto &e : _entities)
+            e->destroy();
+        refresh();
+
+        ByteStream& layout { snapshot.layout };
+        layout.rewind();
+
+        while (!layout.eof())
+        {
+            Entity& entity { addEntity() };
+            GroupBitset groups { layout.read<std::uint32_t>() };
+
+            const auto count { layout.read<std::uint8_t>() };
+            for (auto i { 0u }; i < count; ++i)
+                loadComponent(entity, layout.read<std::uint8_t>(), snapshot.state);
+
+            assignGroups(entity, groups);
+        }
+
+        link();
+
+        // restore is a sync point too: rebuilt entities are reported at once
+        fireHooks(_constructed, _constructHooks);
+    }
+
+    void Manager::link()
+    {
+        _linkScratch.clear();
+        for (auto &e : _entities)
+        {
+            if (e->isAlive())
+                _linkScratch.push_back(e.get());
+        }
+
+        for (Entity* entity : _linkScratch)
+            entity->Link(_linkScratch);
+    }
+
+    Component& Manager::loadComponent(Entity& entity, ComponenID id, ByteStream& state)
+    {
+        assert(_factories[id] && "component factory not registered");
+
+        Component& component { _factories[id](entity) };
+        component.Load(state);
+
+        return component;
+    }
+
+    void Manager::assignGroups(Entity& entity, const GroupBitset& groups)
+    {
+        for (auto i { 0u }; i < maxGroups; ++i)
+        {
+            if (groups[i])
+                entity.addGroup(i);
+        }
+    }
+
+    void Manager::makePrefab(const Entity& entity, Prefab& prefab) const
+    {
+        prefab.groups = entity.groups();
+        prefab.components = entity.componentTypes();
+
+        prefab.state.clear();
+        entity.SaveState(prefab.state);
+    }
+
+    Entity& Manager::instantiate(Prefab& prefab)
+    {
+        assert(!prefab.empty());
+
+        Entity& entity { addEntity() };
+        entity.reserveComponents(prefab.components.size());
+
+        prefab.state.rewind();
+        for (auto id : prefab.components)
+            loadComponent(entity, id, prefab.state);
+
+        assignGroups(entity, prefab.groups);
+
+        return entity;
+    }
 } // namespace ECS
\ No newline at end of file
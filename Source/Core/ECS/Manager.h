@@ -2,17 +2,34 @@
 
 #include <vector>
 #include <memory>
+#include <tuple>
+#include <utility>
 #include "ECS.h"
+#include "Entity.h"
+#include "Pool.h"
+#include "Prefab.h"
+#include "Snapshot.h"
 #include <assert.h>
 
 namespace ECS
 {
+    // used by snapshot restore to rebuild a component on a fresh entity
+    using ComponentFactory = std::function<Component&(Entity&)>;
+    // structural change hook: all entities that got (or lost) a component type since last refresh
+    using ComponentHook = std::function<void(const EntityList&)>;
+
+    using EntityPtr = std::unique_ptr<Entity, PoolDeleter<Entity>>;
+
     /// TODO: should be renamed Facade or Service locator
     class Manager
     {
     private:
+        // note: pools must be declared first -> destroyed after the entities they own
+        ComponentPools _componentPools;
+        Pool<Entity> _entityPool;
+
         /// TODO: move to entitySystem
-        std::vector<std::unique_ptr<Entity>> _entities;
+        std::vector<EntityPtr> _entities;
         // allow to register entities by groupID
         std::array<EntityList, maxGroups> _groupedEntities;
 
@@ -26,6 +43,40 @@ namespace ECS
         // keep a flag table of system added -> unique system in game
         SystemBitset _systemBitset;
 
+        // component factories indexed by component type ID
+        std::array<ComponentFactory, maxComponents> _factories;
+        // layout of the live world, compared to snapshot layout on restore
+        ByteStream _layoutScratch;
+
+        // hooks by component type ID, pending entities are fired in batch by refresh
+        std::array<std::vector<ComponentHook>, maxComponents> _constructHooks;
+        std::array<std::vector<ComponentHook>, maxComponents> _destroyHooks;
+        std::array<EntityList, maxComponents> _constructed;
+        std::array<EntityList, maxComponents> _destroyed;
+        EntityList _hookBatch;
+        // destroyed since last refresh (no scan of all entities to find them)
+        EntityList _destroyedEntities;
+
+        // alive entities in snapshot order
+        EntityList _linkScratch;
+
+        void link();
+        void fireHooks(std::array<EntityList, maxComponents>& pending, const std::array<std::vector<ComponentHook>, maxComponents>& hooks);
+        void rebuild(Snapshot& snapshot);
+        Component& loadComponent(Entity& entity, ComponenID id, ByteStream& state);
+        void assignGroups(Entity& entity, const GroupBitset& groups);
+
+        template<typename... Cs, typename F, std::size_t... Is>
+        void createEntity(std::size_t index, F& initializer, std::index_sequence<Is...>)
+        {
+            Entity& entity { addEntity() };
+            entity.reserveComponents(sizeof...(Cs));
+
+            // note: braced list warranty construction order (= component update and snapshot layout order)
+            std::tuple<Cs&...> components { entity.addComponent<Cs>(entity)... };
+            initializer(index, entity, std::get<Is>(components)...);
+        }
+
     public:
         ~Manager();
         void Update(float mFT);
@@ -34,10 +85,80 @@ namespace ECS
         void addToGroup(Entity *entity, Group group);
         EntityList &getEntitiesByGroup(Group group);
 
+        // structural sync point: fire construct then destroy hooks, then release destroyed entities
         void refresh();
 
         Entity &addEntity();
 
+        // bulk creation: count entities with the same component signature
+        // - storage is reserved once for all entities and components
+        // - components are constructed in place from Entity&, no factory nor Load
+        // - initializer(index, entity, Cs&...) set instance values and groups
+        template<typename... Cs, typename F>
+        void createEntities(std::size_t count, F&& initializer)
+        {
+            static_assert(sizeof...(Cs) > 0, "at least one component is expected");
+
+            reserveEntities(count);
+            _entityPool.reserve(count);
+            // C++14 pack expansion trick
+            int expand[] { (_componentPools.get<Cs>().reserve(count), 0)... };
+            (void)expand;
+
+            for (std::size_t i { 0 }; i < count; ++i)
+                createEntity<Cs...>(i, initializer, std::index_sequence_for<Cs...>{});
+        }
+
+        ComponentPools &componentPools() noexcept { return _componentPools; }
+
+        // preallocate room for count more entities (bulk insert)
+        void reserveEntities(std::size_t count);
+        void reserveGroup(Group group, std::size_t count);
+
+        // snapshot: only alive entities are captured
+        // note: restore is in place when entity layout did not change, otherwise world is rebuilt
+        void save(Snapshot& snapshot) const;
+        void restore(Snapshot& snapshot);
+
+        // prefab: capture an entity once, then copy it (factories must be registered)
+        void makePrefab(const Entity& entity, Prefab& prefab) const;
+        Entity& instantiate(Prefab& prefab);
+
+        template<typename T, typename F>
+        void registerFactory(F&& factory)
+        {
+            _factories[getComponentTypeID<T>()] = std::forward<F>(factory);
+        }
+
+        // hook(entities) at refresh for entities that got a T since the previous one
+        // note: components are fully set up (prefab patch, snapshot load) when it is fired
+        template<typename T, typename F>
+        void onConstruct(F&& hook)
+        {
+            _constructHooks[getComponentTypeID<T>()].emplace_back(std::forward<F>(hook));
+        }
+
+        // hook(entities) at refresh for destroyed entities owning a T, they are still valid during the call
+        // note: an entity created and destroyed between two refreshes is given to both, construct first
+        template<typename T, typename F>
+        void onDestroy(F&& hook)
+        {
+            _destroyHooks[getComponentTypeID<T>()].emplace_back(std::forward<F>(hook));
+        }
+
+        // called by Entity::addComponent, only hooked types are queued
+        void componentAdded(Entity& entity, ComponenID id)
+        {
+            if (!_constructHooks[id].empty())
+                _constructed[id].push_back(&entity);
+        }
+
+        // called once by Entity::destroy
+        void entityDestroyed(Entity& entity)
+        {
+            _destroyedEntities.push_back(&entity);
+        }
+
         template<typename T> bool hasSystem() const
         {
             return _systemBitset[getSystemTypeID<T>()];
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ECS.h"
+
+namespace ECS
+{
+    // Type erased access used by deleters: Base is the common type stored (Component, Entity)
+    template<typename Base>
+    class PoolBase
+    {
+    public:
+        virtual ~PoolBase() = default;
+        virtual void destroy(Base* object) = 0;
+        virtual void reserve(std::size_t count) = 0;
+    };
+
+    // give back memory to the pool instead of the heap
+    template<typename Base>
+    struct PoolDeleter
+    {
+        PoolBase<Base>* pool = nullptr;
+
+        void operator()(Base* object) const
+        {
+            pool->destroy(object);
+        }
+    };
+
+    // Chunked storage with stable address:
+    // - one allocation per chunk instead of one per object
+    // - objects of the same type are packed together (cache friendly iteration)
+    template<typename T, typename Base = T>
+    class Pool final : public PoolBase<Base>
+    {
+        static_assert(std::is_base_of<Base, T>::value, "T must inherit from Base");
+        static constexpr std::size_t chunkSize { 256 };
+
+        using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+        std::vector<std::unique_ptr<Storage[]>> _chunks;
+        // released slots, popped from the back -> lowest address first
+        std::vector<T*> _free;
+        std::size_t _alive { 0 };
+
+        void grow()
+        {
+            _chunks.emplace_back(new Storage[chunkSize]);
+            Storage* chunk { _chunks.back().get() };
+
+            // note: new chunk slots are placed below the released ones so freed slots are reused first
+            _free.insert(_free.begin(), chunkSize, nullptr);
+            for (std::size_t i { 0 }; i < chunkSize; ++i)
+                _free[i] = reinterpret_cast<T*>(&chunk[chunkSize - 1 - i]);
+        }
+
+    public:
+        Pool() = default;
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        ~Pool() override
+        {
+            // owners (unique_ptr with PoolDeleter) must be released before the pool
+            assert(_alive == 0);
+        }
+
+        template<typename... TArgs>
+        T* create(TArgs &&... mArgs)
+        {
+            if (_free.empty())
+                grow();
+
+            T* slot { _free.back() };
+            _free.pop_back();
+
+            new (slot) T(std::forward<TArgs>(mArgs)...);
+            ++_alive;
+
+            return slot;
+        }
+
+        void destroy(Base* object) override
+        {
+            T* item { static_cast<T*>(object) };
+            item->~T();
+            _free.push_back(item);
+            --_alive;
+        }
+
+        // ensure count objects can be created without allocating
+        void reserve(std::size_t count) override
+        {
+            while (_free.size() < count)
+                grow();
+        }
+
+        std::size_t alive() const noexcept { return _alive; }
+
+        PoolDeleter<Base> deleter() noexcept { return { this }; }
+    };
+
+    // one pool per component type, created on first use
+    class ComponentPools
+    {
+        std::array<std::unique_ptr<PoolBase<Component>>, maxComponents> _pools;
+
+    public:
+        template<typename T>
+        Pool<T, Component>& get()
+        {
+            auto &pool(_pools[getComponentTypeID<T>()]);
+            if (!pool)
+                pool = std::make_unique<Pool<T, Component>>();
+
+            return static_cast<Pool<T, Component>&>(*pool);
+        }
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <vector>
+#include "ECS.h"
+#include "Snapshot.h"
+
+namespace ECS
+{
+    // Precomputed entity: signature + component state blob captured once
+    // note: instantiate copy the blob into new components then caller patch instance values (position, ...)
+    struct Prefab
+    {
+        GroupBitset groups;
+        // component types in insertion order
+        std::vector<ComponenID> components;
+        ByteStream state;
+
+        bool empty() const noexcept { return components.empty(); }
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace ECS
+{
+    // Raw binary stream: POD state is copied with memcpy
+    // note: capacity is kept on clear -> no allocation once the stream reached its size
+    class ByteStream
+    {
+        std::vector<std::uint8_t> _bytes;
+        std::size_t _cursor { 0 };
+
+    public:
+        template<typename T> void write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+            const std::size_t offset { _bytes.size() };
+            _bytes.resize(offset + sizeof(T));
+            std::memcpy(_bytes.data() + offset, &value, sizeof(T));
+        }
+
+        template<typename T> void read(T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+            assert(_cursor + sizeof(T) <= _bytes.size());
+
+            std::memcpy(&value, _bytes.data() + _cursor, sizeof(T));
+            _cursor += sizeof(T);
+        }
+
+        template<typename T> T read()
+        {
+            T value;
+            read(value);
+            return value;
+        }
+
+        void clear() noexcept { _bytes.clear(); _cursor = 0; }
+        void rewind() noexcept { _cursor = 0; }
+
+        bool empty() const noexcept { return _bytes.empty(); }
+        bool eof() const noexcept { return _cursor >= _bytes.size(); }
+        std::size_t size() const noexcept { return _bytes.size(); }
+        const std::uint8_t* data() const noexcept { return _bytes.data(); }
+
+        bool operator==(const ByteStream& other) const noexcept { return _bytes == other._bytes; }
+        bool operator!=(const ByteStream& other) const noexcept { return _bytes != other._bytes; }
+    };
+
+    // World state capture
+    // - layout: entity signatures (groups + component types in insertion order)
+    // - state: component data, in the same order
+    // - globals: state outside entities (rules, random sequence), written and read by the owner
+    // note: snapshots are process local (component type IDs, function pointers)
+    struct Snapshot
+    {
+        ByteStream layout;
+        ByteStream state;
+        ByteStream globals;
+
+        bool empty() const noexcept { return layout.empty(); }
+    };
+}
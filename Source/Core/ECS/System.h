@@ -9,6 +9,8 @@ namespace ECS
     class System
     {
     public:
+        // note: owned through unique_ptr<System> by Manager
+        virtual ~System() = default;
         virtual void initialize(const Manager &_manager) = 0;
         virtual void Draw() {};
     };
@@ -0,0 +1,104 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+namespace Core
+{
+    // initial spin window, then adjusted to the measured sleep overshoot
+    static constexpr std::chrono::microseconds sDefaultSpin { 2000 };
+    static constexpr std::chrono::microseconds sMinSpin { 200 };
+
+    double PacingStats::stdDev() const noexcept
+    {
+        return frames > 1 ? std::sqrt(m2 / (frames - 1)) : 0.;
+    }
+
+    FramePacer::FramePacer(double rate)
+        : _spin{ sDefaultSpin }
+    {
+#ifdef _WIN32
+        // default scheduler tick is 15.6 ms: sleep would overshoot a whole 60 Hz frame
+        timeBeginPeriod(1);
+#endif
+        Rate(rate);
+        start();
+    }
+
+    FramePacer::~FramePacer()
+    {
+#ifdef _WIN32
+        timeEndPeriod(1);
+#endif
+    }
+
+    void FramePacer::Rate(double rate)
+    {
+        _period = rate > 0.
+            ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1. / rate))
+            : Clock::duration::zero();
+    }
+
+    double FramePacer::Rate() const noexcept
+    {
+        return _period > Clock::duration::zero() ? 1. / std::chrono::duration<double>(_period).count() : 0.;
+    }
+
+    void FramePacer::start()
+    {
+        _last = Clock::now();
+        _next = _last + _period;
+    }
+
+    float FramePacer::wait()
+    {
+        if (_period > Clock::duration::zero())
+        {
+            // coarse sleep, woken up a bit early
+            const Clock::time_point wake { _next - _spin };
+            Clock::time_point now { Clock::now() };
+            if (now < wake)
+            {
+                std::this_thread::sleep_until(wake);
+
+                // learn overshoot: next spin window cover the worst recent one
+                const Clock::time_point woken { Clock::now() };
+                const Clock::duration overshoot { woken - wake };
+                _spin = std::max<Clock::duration>(sMinSpin, std::max(overshoot + overshoot / 2, _spin - _spin / 16));
+            }
+
+            // short spin up to the exact boundary
+            while ((now = Clock::now()) < _next) {}
+
+            record(now - _next);
+
+            // late by more than one frame -> restart from now instead of running frames back to back
+            _next = now - _next > _period ? now + _period : _next + _period;
+        }
+
+        const Clock::time_point now { Clock::now() };
+        const std::chrono::duration<float, std::milli> frame { now - _last };
+        _last = now;
+
+        return frame.count();
+    }
+
+    void FramePacer::record(Clock::duration error)
+    {
+        const double value { std::chrono::duration<double, std::micro>(error).count() };
+
+        ++_stats.frames;
+        const double delta { value - _stats.meanError };
+        _stats.meanError += delta / _stats.frames;
+        _stats.m2 += delta * (value - _stats.meanError);
+        _stats.maxError = std::max(_stats.maxError, value);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+namespace Core
+{
+    // pacing error = wake up time - frame boundary (microseconds)
+    struct PacingStats
+    {
+        std::size_t frames = 0;
+        double meanError = 0.;
+        double maxError = 0.;
+        // note: running variance (Welford), see stdDev()
+        double m2 = 0.;
+
+        double stdDev() const noexcept;
+    };
+
+    // Frame limiter on a monotonic clock: coarse sleep then short spin up to the exact boundary
+    // - sleep overshoot is learned, spin only cover it (low CPU, low jitter)
+    // - boundaries are absolute (next = previous + period): no drift, late frames are not caught up
+    class FramePacer
+    {
+        using Clock = std::chrono::steady_clock;
+
+        Clock::duration _period {};
+        Clock::time_point _next;
+        Clock::time_point _last;
+
+        // time kept for spinning before the boundary, grow with observed sleep overshoot
+        Clock::duration _spin;
+
+        PacingStats _stats;
+
+        void record(Clock::duration error);
+
+    public:
+        // rate = 0 -> unlimited, wait only measure frame time
+        explicit FramePacer(double rate = 60.);
+        ~FramePacer();
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        void Rate(double rate);
+        double Rate() const noexcept;
+
+        // restart boundaries from now
+        void start();
+
+        // block until next frame boundary, return whole frame duration in ms (work + wait)
+        float wait();
+
+        const PacingStats& Stats() const noexcept { return _stats; }
+        void ResetStats() noexcept { _stats = {}; }
+    };
+}
@@ -1,11 +1,72 @@
 #include "Library.h"
 
+#include <chrono>
+
 namespace Core
 {
-    std::array<bool, (size_t)Input::NB_KEYS> Library::sPressedKeys{false};
+    InputState Library::sInput{};
+
+    static std::uint32_t keyMask(Input key)
+    {
+        return 1u << static_cast<std::uint32_t>(key);
+    }
+
+    static std::uint64_t now()
+    {
+        using namespace std::chrono;
+        return static_cast<std::uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+
+    void Library::BeginInputFrame()
+    {
+        sInput.pressed = 0;
+        sInput.released = 0;
+    }
+
+    void Library::SetKey(Input key, bool down)
+    {
+        const std::uint32_t mask { keyMask(key) };
+        const bool wasDown { (sInput.down & mask) != 0 };
+        if (wasDown == down) return;
+
+        // note: press + release in the same frame keep both edges -> short tap is never lost
+        if (down)
+        {
+            sInput.down |= mask;
+            sInput.pressed |= mask;
+        }
+        else
+        {
+            sInput.down &= ~mask;
+            sInput.released |= mask;
+        }
+
+        sInput.timestamps[(size_t)key] = now();
+    }
+
+    void Library::ReleaseAllKeys()
+    {
+        for (size_t i { 0 }; i < (size_t)Input::NB_KEYS; ++i)
+            SetKey(static_cast<Input>(i), false);
+    }
 
     bool Library::KeyPressed(Input key)
     {
-        return Library::sPressedKeys[(int)key];
+        return (sInput.down & keyMask(key)) != 0;
+    }
+
+    bool Library::KeyTriggered(Input key)
+    {
+        return (sInput.pressed & keyMask(key)) != 0;
+    }
+
+    bool Library::KeyReleased(Input key)
+    {
+        return (sInput.released & keyMask(key)) != 0;
+    }
+
+    std::uint64_t Library::KeyTimestamp(Input key)
+    {
+        return sInput.timestamps[(size_t)key];
     }
-}
\ No newline at end of file
+}
@@ -1,9 +1,12 @@
 #pragma once
 #include <string>
 #include <array>
+#include <cstdint>
 
 namespace Core
 {
+    class ThreadPool;
+
     enum class Input
     {
         Space = 0,
@@ -11,27 +14,94 @@ namespace Core
         Down,
         Left,
         Right,
+        Escape,
+        R,
+        F5,
+        F9,
+        Backspace,
 
         NB_KEYS
     };
 
+    // Input state of one frame, sampled once from the event stream
+    // note: POD -> can be recorded in a replay and injected back (headless, tests)
+    struct InputState
+    {
+        // bit = (1 << Input)
+        std::uint32_t down;     // held
+        std::uint32_t pressed;  // press edge since previous frame
+        std::uint32_t released; // release edge since previous frame
+        // last transition by key (microseconds, monotonic clock)
+        std::array<std::uint64_t, (size_t)Input::NB_KEYS> timestamps;
+    };
+
+    static_assert((size_t)Input::NB_KEYS <= 32, "InputState mask is 32 bit");
+
+    // RGBA packed colour (same layout as sf::Color::toInteger)
+    using Color = std::uint32_t;
+
+    namespace Colors
+    {
+        constexpr Color Black{ 0x000000FF }, White{ 0xFFFFFFFF }, Red{ 0xFF0000FF }, Green{ 0x00FF00FF };
+        constexpr Color Blue{ 0x0000FFFF }, Yellow{ 0xFFFF00FF }, Magenta{ 0xFF00FFFF }, Cyan{ 0x00FFFFFF };
+    }
+
+    // one instance by shape: backend draw a whole span in one call
+    struct RectangleInstance
+    {
+        float left, top, width, height;
+        Color color;
+    };
+
+    struct CircleInstance
+    {
+        // center
+        float x, y, radius;
+        Color color;
+    };
+
     class Library
     {
     // Input
     private:
-        static std::array<bool, (size_t)Input::NB_KEYS> sPressedKeys;
+        static InputState sInput;
+    protected:
+        // backends call it from RefreshInput: clear edges then apply device events
+        static void BeginInputFrame();
+        static void SetKey(Input key, bool down);
+        static void ReleaseAllKeys();
     public:
+        virtual ~Library() = default;
+
+        // sample devices once per frame, every consumer read the same snapshot
         virtual void RefreshInput() = 0;
         static bool KeyPressed(Input key);
+        // pressed since previous refresh
+        static bool KeyTriggered(Input key);
+        // released since previous refresh
+        static bool KeyReleased(Input key);
+        static std::uint64_t KeyTimestamp(Input key);
 
-    // Render
+        // replay: record/inject a whole frame
+        static const InputState& State() noexcept { return sInput; }
+        static void OverrideState(const InputState& state) noexcept { sInput = state; }
+
+    // Window
     public:
         virtual void CreateWindow(int width, int height, const std::string& title) = 0;
         virtual void ReleaseWindow() = 0;
+        virtual bool IsWindowOpen() const = 0;
+        virtual void SetTitle(const std::string&) {}
+        virtual void SetFramerateLimit(unsigned int) {}
+
+    // Render
+    public:
         virtual void StartRender() {}
         virtual void EndRender() {}
         virtual void ClearBackground() = 0;
-        virtual void DrawRectangle() = 0;
-        virtual void DrawCircle() = 0;
+        virtual void DrawRectangle(const RectangleInstance* instances, std::size_t count) = 0;
+        virtual void DrawCircle(const CircleInstance* instances, std::size_t count) = 0;
+        // geometry of big spans is built on workers (nullptr -> caller thread only)
+        virtual void SetWorkers(ThreadPool*) {}
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,105 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Core
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+
+        _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+        {
+            _file = nullptr;
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(_file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            close();
+            return false;
+        }
+
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        _data = static_cast<const std::uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (_data == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        _size = static_cast<std::size_t>(fileSize.QuadPart);
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (_data) UnmapViewOfFile(_data);
+        if (_mapping) CloseHandle(_mapping);
+        if (_file) CloseHandle(_file);
+
+        _data = nullptr;
+        _mapping = nullptr;
+        _file = nullptr;
+        _size = 0;
+    }
+#else
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) 
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0)
+        {
+            ::close(fd);
+            return false;
+        }
+
+        void* address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        // note: mapping keep its own reference on the file
+        ::close(fd);
+
+        if (address == MAP_FAILED)
+            return false;
+
+        _data = static_cast<const std::uint8_t*>(address);
+        _size = static_cast<std::size_t>(info.st_size);
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (_data) munmap(const_cast<std::uint8_t*>(_data), _size);
+
+        _data = nullptr;
+        _size = 0;
+    }
+#endif
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Core
+{
+    // Read only memory mapped file
+    // note: data stay valid until close() or destruction -> views can point directly into it (zero copy)
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const noexcept { return _data != nullptr; }
+        const std::uint8_t* data() const noexcept { return _data; }
+        std::size_t size() const noexcept { return _size; }
+
+    private:
+        const std::uint8_t* _data = nullptr;
+        std::size_t _size = 0;
+
+#ifdef _WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+}
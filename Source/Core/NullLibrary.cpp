@@ -0,0 +1,47 @@
+#include "NullLibrary.h"
+
+namespace Core
+{
+    void NullLibrary::RefreshInput()
+    {
+        BeginInputFrame();
+
+        for (const auto &entry : _pendingKeys)
+            SetKey(entry.first, entry.second);
+        _pendingKeys.clear();
+    }
+
+    void NullLibrary::InjectKey(Input key, bool down)
+    {
+        _pendingKeys.emplace_back(key, down);
+    }
+
+    void NullLibrary::CreateWindow(int, int, const std::string&)
+    {
+        _open = true;
+    }
+
+    void NullLibrary::ReleaseWindow()
+    {
+        _open = false;
+    }
+
+    bool NullLibrary::IsWindowOpen() const
+    {
+        return _open;
+    }
+
+    void NullLibrary::ClearBackground()
+    {
+    }
+
+    void NullLibrary::DrawRectangle(const RectangleInstance*, std::size_t count)
+    {
+        _rectangles += count;
+    }
+
+    void NullLibrary::DrawCircle(const CircleInstance*, std::size_t count)
+    {
+        _circles += count;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <utility>
+#include <vector>
+#include "Library.h"
+
+namespace Core
+{
+    // Headless backend: no window, no render
+    // note: used to run and benchmark the game loop without SFML
+    class NullLibrary : public Library
+    {
+        bool _open = false;
+        // scripted key changes applied on next refresh
+        std::vector<std::pair<Input, bool>> _pendingKeys;
+        std::size_t _rectangles = 0;
+        std::size_t _circles = 0;
+
+    public:
+        void RefreshInput() override;
+        void InjectKey(Input key, bool down);
+
+        void CreateWindow(int width, int height, const std::string& title) override;
+        void ReleaseWindow() override;
+        bool IsWindowOpen() const override;
+
+        void ClearBackground() override;
+        void DrawRectangle(const RectangleInstance* instances, std::size_t count) override;
+        void DrawCircle(const CircleInstance* instances, std::size_t count) override;
+
+        // shapes submitted since creation
+        std::size_t DrawnRectangles() const noexcept { return _rectangles; }
+        std::size_t DrawnCircles() const noexcept { return _circles; }
+    };
+}
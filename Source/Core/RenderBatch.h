@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+#include "Library.h"
+
+namespace Core
+{
+    // Shapes collected during draw phase then submitted in one call by shape type
+    // note: vectors keep their capacity between frames
+    struct RenderBatch
+    {
+        std::vector<RectangleInstance> rectangles;
+        std::vector<CircleInstance> circles;
+
+        void clear() noexcept
+        {
+            rectangles.clear();
+            circles.clear();
+        }
+
+        void submit(Library& library) const
+        {
+            if (!rectangles.empty()) library.DrawRectangle(rectangles.data(), rectangles.size());
+            if (!circles.empty()) library.DrawCircle(circles.data(), circles.size());
+        }
+    };
+}
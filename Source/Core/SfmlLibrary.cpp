@@ -0,0 +1,187 @@
+#include "SfmlLibrary.h"
+
+#include <cmath>
+#include "ThreadPool.h"
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+namespace Core
+{
+    // circle approximation used by the batch
+    constexpr std::size_t CIRCLE_SEGMENTS{ 16 };
+    // instances by worker range
+    constexpr std::size_t VERTEX_GRAIN{ 2048 };
+
+    static const std::array<sf::Keyboard::Key, (size_t)Input::NB_KEYS> sKeyMapping
+    {
+        sf::Keyboard::Key::Space,
+        sf::Keyboard::Key::Up,
+        sf::Keyboard::Key::Down,
+        sf::Keyboard::Key::Left,
+        sf::Keyboard::Key::Right,
+        sf::Keyboard::Key::Escape,
+        sf::Keyboard::Key::R,
+        sf::Keyboard::Key::F5,
+        sf::Keyboard::Key::F9,
+        sf::Keyboard::Key::Backspace,
+    };
+
+    static bool toInput(sf::Keyboard::Key code, Input& key)
+    {
+        for (size_t i { 0 }; i < sKeyMapping.size(); ++i)
+        {
+            if (sKeyMapping[i] == code)
+            {
+                key = static_cast<Input>(i);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void SfmlLibrary::RefreshInput()
+    {
+        BeginInputFrame();
+
+        // note: key state come from the event stream only (no per key OS polling)
+        // SFML tips: prevent window freezing
+        sf::Event event;
+        Input key;
+        while (_window->pollEvent(event))
+        {
+            switch (event.type)
+            {
+            case sf::Event::Closed:
+                _window->close();
+                return;
+            case sf::Event::KeyPressed:
+                if (toInput(event.key.code, key)) SetKey(key, true);
+                break;
+            case sf::Event::KeyReleased:
+                if (toInput(event.key.code, key)) SetKey(key, false);
+                break;
+            // release event is not received when focus is lost
+            case sf::Event::LostFocus:
+                ReleaseAllKeys();
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void SfmlLibrary::CreateWindow(int width, int height, const std::string& title)
+    {
+        _window = std::make_unique<sf::RenderWindow>(sf::VideoMode{ static_cast<unsigned int>(width), static_cast<unsigned int>(height) }, title);
+    }
+
+    void SfmlLibrary::ReleaseWindow()
+    {
+        _window.reset();
+    }
+
+    bool SfmlLibrary::IsWindowOpen() const
+    {
+        return _window && _window->isOpen();
+    }
+
+    void SfmlLibrary::SetTitle(const std::string& title)
+    {
+        _window->setTitle(title);
+    }
+
+    void SfmlLibrary::SetFramerateLimit(unsigned int limit)
+    {
+        _window->setFramerateLimit(limit);
+    }
+
+    void SfmlLibrary::EndRender()
+    {
+        _window->display();
+    }
+
+    void SfmlLibrary::ClearBackground()
+    {
+        _window->clear(sf::Color::Black);
+    }
+
+    template<typename F>
+    void SfmlLibrary::generate(std::size_t count, const F& fill)
+    {
+        // note: below one grain a worker wake up cost more than the work
+        if (_workers) _workers->parallelFor(count, fill, VERTEX_GRAIN);
+        else fill(0, count);
+    }
+
+    void SfmlLibrary::DrawRectangle(const RectangleInstance* instances, std::size_t count)
+    {
+        if (count == 0) return;
+
+        _vertices.resize(count * 6);
+        // note: storage is contiguous, ranges of instances map to disjoint ranges of vertices
+        sf::Vertex* vertices { &_vertices[0] };
+
+        generate(count, [instances, vertices](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+            {
+                const RectangleInstance& rect { instances[i] };
+                const sf::Color color { rect.color };
+                const float right { rect.left + rect.width }, bottom { rect.top + rect.height };
+
+                // 2 triangles by rectangle
+                sf::Vertex* quad { vertices + i * 6 };
+                quad[0] = sf::Vertex{ { rect.left, rect.top }, color };
+                quad[1] = sf::Vertex{ { right, rect.top }, color };
+                quad[2] = sf::Vertex{ { right, bottom }, color };
+                quad[3] = sf::Vertex{ { rect.left, rect.top }, color };
+                quad[4] = sf::Vertex{ { right, bottom }, color };
+                quad[5] = sf::Vertex{ { rect.left, bottom }, color };
+            }
+        });
+
+        _window->draw(_vertices);
+    }
+
+    void SfmlLibrary::DrawCircle(const CircleInstance* instances, std::size_t count)
+    {
+        if (count == 0) return;
+
+        // unit circle computed once
+        static const std::array<sf::Vector2f, CIRCLE_SEGMENTS + 1> sUnit = []
+        {
+            std::array<sf::Vector2f, CIRCLE_SEGMENTS + 1> points;
+            for (std::size_t i { 0 }; i <= CIRCLE_SEGMENTS; ++i)
+            {
+                const float angle { 2.f * 3.14159265f * i / CIRCLE_SEGMENTS };
+                points[i] = { std::cos(angle), std::sin(angle) };
+            }
+            return points;
+        }();
+
+        _vertices.resize(count * CIRCLE_SEGMENTS * 3);
+        sf::Vertex* vertices { &_vertices[0] };
+
+        generate(count, [instances, vertices](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+            {
+                const CircleInstance& circle { instances[i] };
+                const sf::Color color { circle.color };
+                const sf::Vector2f center { circle.x, circle.y };
+
+                // triangle fan unrolled as triangle list -> whole batch in one draw call
+                sf::Vertex* fan { vertices + i * CIRCLE_SEGMENTS * 3 };
+                for (std::size_t s { 0 }; s < CIRCLE_SEGMENTS; ++s)
+                {
+                    fan[s * 3 + 0] = sf::Vertex{ center, color };
+                    fan[s * 3 + 1] = sf::Vertex{ center + sUnit[s] * circle.radius, color };
+                    fan[s * 3 + 2] = sf::Vertex{ center + sUnit[s + 1] * circle.radius, color };
+                }
+            }
+        });
+
+        _window->draw(_vertices);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <memory>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "Library.h"
+
+namespace Core
+{
+    // SFML backend: each span of shapes become one vertex array and one draw call
+    class SfmlLibrary : public Library
+    {
+        std::unique_ptr<sf::RenderWindow> _window;
+        // reused between calls to avoid allocation
+        sf::VertexArray _vertices{ sf::Triangles };
+        // optional, each worker fill a disjoint range of _vertices
+        ThreadPool* _workers = nullptr;
+
+        // run fill(begin, end) over instances, split across workers when worth it
+        template<typename F>
+        void generate(std::size_t count, const F& fill);
+
+    public:
+        void RefreshInput() override;
+
+        void CreateWindow(int width, int height, const std::string& title) override;
+        void ReleaseWindow() override;
+        bool IsWindowOpen() const override;
+        void SetTitle(const std::string& title) override;
+        void SetFramerateLimit(unsigned int limit) override;
+
+        void EndRender() override;
+        void ClearBackground() override;
+        void DrawRectangle(const RectangleInstance* instances, std::size_t count) override;
+        void DrawCircle(const CircleInstance* instances, std::size_t count) override;
+        void SetWorkers(ThreadPool* workers) override { _workers = workers; }
+    };
+}
@@ -0,0 +1,100 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Core
+{
+    ThreadPool::ThreadPool(std::size_t threads)
+    {
+        if (threads == 0)
+            threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        // note: caller is the last thread
+        _workers.reserve(threads - 1);
+        for (std::size_t i { 1 }; i < threads; ++i)
+            _workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wakeUp.notify_all();
+
+        for (auto &worker : _workers)
+            worker.join();
+    }
+
+    void ThreadPool::parallelFor(std::size_t count, const Job& job, std::size_t grain)
+    {
+        if (count == 0) return;
+        grain = std::max<std::size_t>(1, grain);
+
+        // not worth waking anyone
+        if (_workers.empty() || count <= grain)
+        {
+            job(0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = &job;
+            _count = count;
+            _grain = grain;
+            _next.store(0, std::memory_order_relaxed);
+            _busy = _workers.size();
+            ++_generation;
+        }
+        _wakeUp.notify_all();
+
+        process(job, count, grain);
+
+        // job lifetime is the caller stack: wait every worker left it
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _busy == 0; });
+        _job = nullptr;
+    }
+
+    void ThreadPool::process(const Job& job, std::size_t count, std::size_t grain)
+    {
+        for (;;)
+        {
+            const std::size_t begin { _next.fetch_add(grain, std::memory_order_relaxed) };
+            if (begin >= count) return;
+
+            job(begin, std::min(begin + grain, count));
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        std::uint64_t seen { 0 };
+
+        for (;;)
+        {
+            const Job* job;
+            std::size_t count, grain;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wakeUp.wait(lock, [this, seen] { return _stop || _generation != seen; });
+                if (_stop) return;
+
+                seen = _generation;
+                job = _job;
+                count = _count;
+                grain = _grain;
+            }
+
+            process(*job, count, grain);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --_busy;
+            }
+            _done.notify_one();
+        }
+    }
+}
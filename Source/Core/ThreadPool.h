@@ -0,0 +1,54 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+    // Fixed set of workers sleeping between jobs
+    // note: one job at a time, the caller thread take part in it (workers + 1 threads busy)
+    class ThreadPool
+    {
+        using Job = std::function<void(std::size_t begin, std::size_t end)>;
+
+        std::vector<std::thread> _workers;
+
+        std::mutex _mutex;
+        std::condition_variable _wakeUp;
+        std::condition_variable _done;
+
+        // current job, published under _mutex
+        const Job* _job = nullptr;
+        std::size_t _count = 0;
+        std::size_t _grain = 1;
+        std::uint64_t _generation = 0;
+        std::size_t _busy = 0;
+        bool _stop = false;
+
+        // next range to process, shared by every thread of the job
+        std::atomic<std::size_t> _next { 0 };
+
+        void workerLoop();
+        void process(const Job& job, std::size_t count, std::size_t grain);
+
+    public:
+        // threads = 0 -> hardware concurrency
+        explicit ThreadPool(std::size_t threads = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // call job(begin, end) on ranges covering [0, count), return when all ranges are done
+        // note: ranges of grain items are dealt on demand -> uneven items are balanced
+        void parallelFor(std::size_t count, const Job& job, std::size_t grain = 1);
+
+        // worker threads + caller
+        std::size_t concurrency() const noexcept { return _workers.size() + 1; }
+    };
+}
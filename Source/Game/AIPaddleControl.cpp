@@ -0,0 +1,61 @@
+#include "AIPaddleControl.h"
+#include "Arkanoid_Command.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    AIPaddleControl::AIPaddleControl(std::unique_ptr<PaddleBrain> brain)
+        : _brain{ brain ? std::move(brain) : std::make_unique<TrackingBrain>() }
+    {}
+
+    AIPaddleControl& AIPaddleControl::Brain(std::unique_ptr<PaddleBrain> brain)
+    {
+        _brain = std::move(brain);
+        return *this;
+    }
+
+    void AIPaddleControl::reserve(std::size_t worlds)
+    {
+        _observations.reserve(worlds);
+        _actions.reserve(worlds);
+        _targets.reserve(worlds);
+    }
+
+    void AIPaddleControl::observe(CommandSystem& commands, Entity& paddle, const Entity& ball)
+    {
+        const CPhysics& cpBall = ball.getComponent<CPhysics>();
+        const CPhysics& cpPaddle = paddle.getComponent<CPhysics>();
+
+        const CVect2& pBall = cpBall.Position();
+        const CVect2& pPaddle = cpPaddle.Position();
+
+        _observations.push_back(PaddleObservation{
+            static_cast<float>(pBall.x), static_cast<float>(pBall.y),
+            static_cast<float>(cpBall.Velocity().x), static_cast<float>(cpBall.Velocity().y),
+            static_cast<float>(pPaddle.x), static_cast<float>(pPaddle.y),
+            static_cast<float>(cpPaddle.HalfSize().x) });
+        _targets.push_back(Target{ &commands, &paddle });
+    }
+
+    void AIPaddleControl::decide()
+    {
+        _actions.resize(_observations.size());
+
+        if (!_observations.empty())
+            _brain->decide(_observations.data(), _actions.data(), _observations.size());
+
+        // note: same rule as player input, only direction changes become commands
+        for (std::size_t i { 0 }; i < _targets.size(); ++i)
+        {
+            const Target& target{ _targets[i] };
+            if (target.paddle->getComponent<CPaddleControl>().Direction() != _actions[i])
+                target.commands->push(*target.paddle, CommandType::MovePaddle, _actions[i]);
+        }
+
+        _observations.clear();
+        _targets.clear();
+    }
+}
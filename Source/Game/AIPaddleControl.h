@@ -0,0 +1,48 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "PaddleBrain.h"
+
+namespace ECS
+{
+    class Entity;
+}
+
+namespace Arkanoid
+{
+    class CommandSystem;
+
+    // Replace keyboard by a brain for any number of worlds:
+    // worlds observe their paddle, one decide call, actions go back as MovePaddle commands
+    class AIPaddleControl
+    {
+        struct Target
+        {
+            CommandSystem* commands;
+            ECS::Entity* paddle;
+        };
+
+        std::unique_ptr<PaddleBrain> _brain;
+
+        // packed by world, index match between the three arrays
+        std::vector<PaddleObservation> _observations;
+        std::vector<PaddleAction> _actions;
+        std::vector<Target> _targets;
+
+    public:
+        explicit AIPaddleControl(std::unique_ptr<PaddleBrain> brain = nullptr);
+
+        AIPaddleControl& Brain(std::unique_ptr<PaddleBrain> brain);
+
+        // ensure worlds can be observed without allocating
+        void reserve(std::size_t worlds);
+
+        // paddle follows the given ball, commands are pushed to the world funnel
+        void observe(CommandSystem& commands, ECS::Entity& paddle, const ECS::Entity& ball);
+
+        // one brain call for every observed world, then observations are cleared
+        void decide();
+
+        std::size_t size() const noexcept { return _observations.size(); }
+    };
+}
@@ -5,29 +5,188 @@
 
 #include "ArkanoidConfig.h"
 #include "Game.h"
+#include "LevelGenerator.h"
+#include "NullLibrary.h"
+#include "ThreadPool.h"
+#include "WorldRunner.h"
 //#include "Arkanoid_Classic.h"
 #include <vector>
 #include <iostream>
 #include <cassert>
 #include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <string>
 
 // Main
 //------
 using namespace Arkanoid;
 
-int main(int argc, char *argv[])
+// worker threads asked on the command line (0 -> hardware concurrency)
+static constexpr std::uint64_t MAX_THREADS{ 256 };
+
+static void usage(const char* program)
+{
+	std::cout << "Usage: " << program << " [level.lvl [board]]" << std::endl;
+	std::cout << "       " << program << " --compile levels.txt levels.lvl" << std::endl;
+	std::cout << "       " << program << " --generate count seed levels.lvl [threads]" << std::endl;
+	std::cout << "       " << program << " --headless frames [--ai] [--tick hz] [--refresh-frame] [--fps hz]" << std::endl;
+	std::cout << "       " << program << " --worlds[-lanes] count [frames [threads [level.lvl]]]" << std::endl;
+}
+
+// unsigned argument in [0, max]
+// note: std::stoul accept "-1" and wrap it to ULONG_MAX -> the sign is rejected first
+static std::uint64_t parseUnsigned(const char* text, const char* name, std::uint64_t max = std::numeric_limits<std::uint32_t>::max())
+{
+	const std::string value{ text };
+	if (value.find('-') != std::string::npos)
+		throw std::out_of_range{ std::string{ name } + " must not be negative" };
+
+	const std::uint64_t number{ std::stoull(value) };
+	if (number > max)
+		throw std::out_of_range{ std::string{ name } + " must be <= " + std::to_string(max) };
+
+	return number;
+}
+
+static int run(int argc, char *argv[])
 {
 	if (argc < 2) 
 	{
 		// report version
 		std::cout << argv[0] << " Version " << Arkanoid_VERSION_MAJOR << "."
               << Arkanoid_VERSION_MINOR << std::endl;
-		std::cout << "Usage: " << argv[0] << " number" << std::endl;
+		usage(argv[0]);
 
+#ifdef ARKANOID_SFML
 		Game{}.run();
+#endif
 
 		return 1;
 	}
 
+	const std::string command{ argv[1] };
+
+	// text level -> binary level pack
+	if (command == "--compile")
+	{
+		if (argc < 4)
+		{
+			usage(argv[0]);
+			return 1;
+		}
+		return compileLevels(argv[2], argv[3]) ? 0 : 1;
+	}
+
+	// seeded procedural boards -> binary level pack
+	if (command == "--generate")
+	{
+		if (argc < 5)
+		{
+			usage(argv[0]);
+			return 1;
+		}
+		// note: brick offsets of the pack are 32 bit -> every board at its largest must fit
+		const LevelGenerator generator;
+		const std::uint64_t cells{ std::max<std::uint64_t>(std::uint64_t{ generator.settings().columns } * generator.settings().rows, 1) };
+		const std::uint32_t count = static_cast<std::uint32_t>(parseUnsigned(argv[2], "count", std::numeric_limits<std::uint32_t>::max() / cells));
+		const std::uint64_t seed = std::stoull(argv[3]);
+		Core::ThreadPool pool{ argc > 5 ? parseUnsigned(argv[5], "threads", MAX_THREADS) : 0 };
+
+		const auto start = std::chrono::steady_clock::now();
+		BoardSet set;
+		generator.generate(seed, count, set, pool);
+		const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+
+		std::cout << set.size() << " boards, " << set.bricks.size() << " bricks in " << elapsed.count() << " s ("
+			<< pool.concurrency() << " threads)" << std::endl;
+		return writeLevelPack(argv[4], set) ? 0 : 1;
+	}
+
+	// game loop without window/render (profiling)
+	if (command == "--headless")
+	{
+		const std::size_t frames = argc > 2 ? parseUnsigned(argv[2], "frames") : 1000;
+		Game game{ std::make_unique<Core::NullLibrary>() };
+		Timestep timestep;
+		// headless run unlimited unless a rate is given (pacing check)
+		game.framerate(0.);
+		// note: no player on a null backend, ball is launched as soon as it is served
+		game.autoLaunch(true);
+
+		for (int i{ 3 }; i < argc; ++i)
+		{
+			const std::string option{ argv[i] };
+			if (option == "--ai") game.useAI();
+			else if (option == "--tick" && i + 1 < argc) timestep.tickRate = std::stof(argv[++i]);
+			else if (option == "--refresh-frame") timestep.refreshEachStep = false;
+			else if (option == "--fps" && i + 1 < argc) game.framerate(std::stod(argv[++i]));
+		}
+		if (!timestep.valid()) throw std::invalid_argument("--tick must be a finite rate >= " + std::to_string(static_cast<int>(MIN_TICK_RATE)) + " Hz");
+		game.timestep(timestep);
+
+		game.run(frames);
+
+		const Core::PacingStats& pacing{ game.pacing() };
+		if (pacing.frames > 0)
+			std::cout << "pacing error (us): mean " << pacing.meanError << " stddev " << pacing.stdDev()
+				<< " max " << pacing.maxError << " over " << pacing.frames << " frames" << std::endl;
+		return 0;
+	}
+
+	// many AI driven worlds stepped in parallel (evaluation sweep benchmark)
+	// -lanes: balls of 8 worlds integrated side by side in SoA
+	if (command == "--worlds" || command == "--worlds-lanes")
+	{
+		const std::size_t worlds = argc > 2 ? parseUnsigned(argv[2], "count") : 1000;
+		const std::size_t frames = argc > 3 ? parseUnsigned(argv[3], "frames") : 100;
+		const std::size_t threads = argc > 4 ? parseUnsigned(argv[4], "threads", MAX_THREADS) : 0;
+
+		WorldRunner runner{ worlds, threads };
+		runner.vectorized(command == "--worlds-lanes");
+
+		LevelPack pack;
+		if (argc > 5)
+		{
+			if (!pack.open(argv[5])) return 1;
+			runner.loadBoards(pack);
+		}
+
+		const RunnerStats stats{ runner.run(frames) };
+		std::cout << stats.worlds << " worlds, " << stats.threads << " threads: "
+			<< stats.steps << " steps in " << stats.seconds << " s -> "
+			<< static_cast<std::uint64_t>(stats.stepsPerSecond()) << " steps/s, "
+			<< stats.completed << " boards cleared" << std::endl;
+		return 0;
+	}
+
+	// note: arguments are checked before a window is opened
+	const std::uint32_t board = argc > 2 ? static_cast<std::uint32_t>(parseUnsigned(argv[2], "board")) : 0;
+#ifdef ARKANOID_SFML
+	Game game;
+	if (!game.loadLevel(command, board)) return 1;
+
+	game.run();
+
 	return 0;
-}
\ No newline at end of file
+#else
+	std::cerr << "Built without SFML (ARKANOID_SFML=OFF): no window to play board " << board << " of " << command << std::endl;
+	return 1;
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+	// note: numbers are parsed with std::sto* -> bad input is reported instead of aborting
+	try
+	{
+		return run(argc, argv);
+	}
+	catch (const std::logic_error& error)
+	{
+		std::cerr << "Invalid argument (" << error.what() << ")" << std::endl;
+		usage(argv[0]);
+		return 1;
+	}
+}
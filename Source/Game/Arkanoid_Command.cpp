@@ -0,0 +1,95 @@
+#include "Arkanoid_Command.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+#include "Manager.h"
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    CommandSystem::CommandSystem(Manager& manager)
+    {
+        manager.onDestroy<CPosition>([this](const EntityList&) { forget(); });
+    }
+
+    void CommandSystem::forget()
+    {
+        // note: every target is still in memory during destroy hooks -> isAlive is safe to read
+        auto invalidate = [](GameCommand& command)
+        {
+            if (command.target && !command.target->isAlive()) command.target = nullptr;
+        };
+
+        _buffer.forEach(invalidate);
+        _undoLog.forEach(invalidate);
+    }
+
+    void CommandSystem::push(Entity& target, CommandType type, std::int8_t direction)
+    {
+        _buffer.push(GameCommand{ &target, type, direction, 0, {} });
+    }
+
+    void CommandSystem::execute()
+    {
+        _buffer.execute([this](GameCommand& command)
+        {
+            // note: entity may be destroyed between emission and execution
+            if (!command.target || !command.target->isAlive()) return;
+
+            apply(command);
+            _undoLog.push(command);
+        });
+    }
+
+    std::size_t CommandSystem::undo(std::size_t count)
+    {
+        std::size_t undone { 0 };
+        GameCommand command;
+
+        while (undone < count && _undoLog.pop(command))
+        {
+            if (!command.target || !command.target->isAlive()) continue;
+
+            revert(command);
+            ++undone;
+        }
+
+        return undone;
+    }
+
+    void CommandSystem::clear() noexcept
+    {
+        _buffer.clear();
+        _undoLog.clear();
+    }
+
+    void CommandSystem::apply(GameCommand& command)
+    {
+        Entity& entity = *command.target;
+
+        switch (command.type)
+        {
+        case CommandType::MovePaddle:
+        {
+            auto& control = entity.getComponent<CPaddleControl>();
+            command.previousDirection = control.Direction();
+            command.previousPosition = entity.getComponent<CPosition>().Get();
+            control.Direction(command.direction);
+            break;
+        }
+        }
+    }
+
+    void CommandSystem::revert(const GameCommand& command)
+    {
+        Entity& entity = *command.target;
+
+        switch (command.type)
+        {
+        case CommandType::MovePaddle:
+            entity.getComponent<CPaddleControl>().Direction(command.previousDirection);
+            entity.getComponent<CPosition>().Set(command.previousPosition);
+            break;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include "Arkanoid_Global.h"
+#include "Command.h"
+#include "System.h"
+
+namespace ECS
+{
+    class Entity;
+    class Manager;
+}
+
+namespace Arkanoid
+{
+    enum class CommandType : std::uint8_t
+    {
+        MovePaddle
+    };
+
+    // compact record emitted by input, AI or network
+    // note: POD -> batched in a flat buffer, kept by value in the undo log
+    struct GameCommand
+    {
+        // nullptr once the entity is destroyed (record is then skipped)
+        ECS::Entity* target;
+        CommandType type;
+        // -1 left, 0 stop, 1 right
+        std::int8_t direction;
+
+        // filled on execution, used by undo
+        std::int8_t previousDirection;
+        CVect2 previousPosition;
+    };
+
+    // Single funnel of every gameplay command: executed in batch once per frame
+    class CommandSystem : public ECS::System
+    {
+        static constexpr std::size_t undoDepth { 64 };
+
+        Event::CommandBuffer<GameCommand> _buffer;
+        Event::UndoLog<GameCommand, undoDepth> _undoLog;
+
+        static void apply(GameCommand& command);
+        static void revert(const GameCommand& command);
+
+        // drop targets destroyed this refresh, before their memory is released
+        void forget();
+
+    public:
+        // note: targets must own a CPosition, its destroy hook invalidate the records
+        explicit CommandSystem(ECS::Manager& manager);
+
+        void initialize(const ECS::Manager&) override {}
+
+        void push(ECS::Entity& target, CommandType type, std::int8_t direction);
+
+        // run pending commands in emission order, they are then undoable
+        void execute();
+        // rewind up to count executed commands, return how many were undone (records of destroyed targets are dropped)
+        std::size_t undo(std::size_t count = 1);
+
+        // entities referenced by records are gone (restore, board reload)
+        void clear() noexcept;
+
+        std::size_t pending() const noexcept { return _buffer.size(); }
+        std::size_t undoable() const noexcept { return _undoLog.size(); }
+    };
+}
@@ -2,16 +2,22 @@
 
 #include "Arkanoid_ECS.h"
 
-#include <SFML/Graphics.hpp>
 #include "Arkanoid_Global.h"
 #include "CMath.h"
-#include "Game.h"
+#include "Library.h"
 #include "Entity.h"
+#include "Snapshot.h"
 
 using namespace ECS;
 
 namespace Arkanoid
 {
+    // physics space -> render space
+    static CMath::Vect2 toRender(const CVect2& v)
+    {
+        return { static_cast<float>(v.x), static_cast<float>(v.y) };
+    }
+
     CPosition::CPosition(Entity& entity, const CVect2& position)
         : Component(entity), _position{ position }
     {}
@@ -19,135 +25,348 @@ namespace Arkanoid
     void CPosition::IncPos(const CVect2& dir)
     {
         _position += dir;
+        changed();
+    }
+
+    void CPosition::Save(ByteStream& state) const
+    {
+        state.write(_position);
+    }
+
+    void CPosition::Load(ByteStream& state)
+    {
+        state.read(_position);
+        changed();
     }
 
     CPhysics::CPhysics(Entity& entity, const CVect2& mHalfSize)
-        : Component(entity), _halfSize{ mHalfSize } {}
+        : Component(entity), _velocity{}, _halfSize{ mHalfSize } {}
 
-    void CPhysics::Init()
+    CPhysics& CPhysics::HalfSize(const CVect2& halfSize)
     {
+        _halfSize = halfSize;
+        changed();
+        return *this;
     }
 
     CPhysics& CPhysics::Velocity(const CVect2&& velocity)
     {
         _velocity = velocity;
+        changed();
         return *this;
     }
 
-    CPhysics& CPhysics::Callback(Vect2Callback cb)
+    CPhysics& CPhysics::Bounce(bool bounce) noexcept
     {
-        _onOutOfBounds = cb;
+        _bounce = bounce;
+        changed();
         return *this;
     }
 
     void CPhysics::Update(Frametime ft)
     {
-        _entity.getComponent<CPosition>().IncPos(_velocity * ft);
+        // note: bouncing bodies are integrated in batch by BoundsSystem
+        if (_bounce) return;
 
-        if (_onOutOfBounds == nullptr) return;
-
-        if (left() < 0)	_onOutOfBounds(CVect2{ 1.f, 0.f });
-        else if (right() > SCREEN_WIDTH)	_onOutOfBounds(CVect2{ -1.f, 0.f });
-
-        if (top() < 0) _onOutOfBounds(CVect2{ 0.f, 1.f });
-        else if (bottom() > SCREEN_HEIGHT) _onOutOfBounds(CVect2{ 0.f, -1.f });
+        _entity.getComponent<CPosition>().IncPos(_velocity * Real(ft));
     }
 
-    inline const CVect2& CPhysics::Position() const noexcept
+    const CVect2& CPhysics::Position() const noexcept
     {
         return _entity.getComponent<CPosition>().Get();
     }
 
-    float CPhysics::left() const noexcept
+    Real CPhysics::left() const noexcept
     {
         return Position().x - _halfSize.x;
     }
 
-    float CPhysics::right() const noexcept
+    Real CPhysics::right() const noexcept
     {
         return Position().x + _halfSize.x;
     }
 
-    float CPhysics::top() const noexcept
+    Real CPhysics::top() const noexcept
     {
         return Position().y - _halfSize.y;
     }
 
-    float CPhysics::bottom() const noexcept
+    Real CPhysics::bottom() const noexcept
     {
         return Position().y + _halfSize.y;
     }
 
-    void CCircle::Init()
+    void CPhysics::Save(ByteStream& state) const
+    {
+        state.write(_velocity);
+        state.write(_halfSize);
+        state.write(_bounce);
+    }
+
+    void CPhysics::Load(ByteStream& state)
     {
-        _shape.setRadius(BALL_RADIUS);
-        _shape.setFillColor(sf::Color::Red);
-        _shape.setOrigin(BALL_RADIUS, BALL_RADIUS);
+        state.read(_velocity);
+        state.read(_halfSize);
+        state.read(_bounce);
+        changed();
     }
 
-    CCircle::CCircle(Entity& entity, Game* context, float radius)
-        : Component(entity), _context{ context }, _radius{ radius }{}
+    // ordinal of a detached CParent
+    static constexpr std::uint32_t NO_PARENT { 0xFFFFFFFFu };
+
+    CParent::CParent(Entity& entity)
+        : Component(entity) {}
 
-    CCircle& CCircle::Color(sf::Color mColor)
+    CParent& CParent::Parent(Entity* parent) noexcept
     {
-        _shape.setFillColor(mColor);
+        assert(parent != &_entity);
+        _parent = parent;
+        changed();
         return *this;
     }
 
-    void CCircle::Update(Frametime)
+    CParent& CParent::Local(const CVect2& local) noexcept
     {
-        _shape.setPosition(_entity.getComponent<CPosition>().Get());
+        _local = local;
+        changed();
+        return *this;
+    }
+
+    void CParent::Save(ByteStream& state) const
+    {
+        // note: ordinals are set by Manager::save, only alive entities get one
+        const std::uint32_t ordinal { _parent && _parent->isAlive() ? _parent->ordinal() : NO_PARENT };
+        state.write(ordinal);
+        state.write(_local);
+    }
+
+    void CParent::Load(ByteStream& state)
+    {
+        state.read(_ordinal);
+        state.read(_local);
+        _parent = nullptr;
+        changed();
+    }
+
+    void CParent::Link(const EntityList& entities)
+    {
+        _parent = _ordinal < entities.size() ? entities[_ordinal] : nullptr;
+        changed();
+    }
+
+    CCircle::CCircle(Entity& entity, Core::RenderBatch* context, float radius)
+        : Component(entity), _context{ context }, _shape{ 0.f, 0.f, radius, Core::Colors::Red }, _radius{ radius } {}
+
+    CCircle& CCircle::Context(Core::RenderBatch* context)
+    {
+        _context = context;
+        return *this;
+    }
+
+    CCircle& CCircle::Color(Core::Color mColor)
+    {
+        _shape.color = mColor;
+        changed();
+        return *this;
+    }
+
+    void CCircle::sync() noexcept
+    {
+        const CPosition& position = _entity.getComponent<CPosition>();
+        if (position.version() == _synced) return;
+
+        // circle instance is centered on position
+        const CMath::Vect2 center { toRender(position.Get()) };
+        _shape.x = center.x;
+        _shape.y = center.y;
+        _synced = position.version();
     }
 
     void CCircle::Draw()
     { 
-        _context->render(_shape); 
+        sync();
+        _context->circles.push_back(_shape);
     }
 
-    void CRectangle::Init()
+    void CCircle::Save(ByteStream& state) const
     {
-        _shape.setSize({ PADDLE_WIDTH, PADDLE_HEIGHT });
-        _shape.setFillColor(sf::Color::Red);
-        _shape.setOrigin(PADDLE_WIDTH / 2.f, PADDLE_HEIGHT / 2.f);
+        state.write(_radius);
+        state.write(_shape.color);
     }
 
-    CRectangle::CRectangle(Entity& entity, Game* context)
-        : Component(entity), _context{ context } {}
+    void CCircle::Load(ByteStream& state)
+    {
+        state.read(_radius);
+        state.read(_shape.color);
+        _shape.radius = _radius;
+        changed();
+    }
+
+    CRectangle::CRectangle(Entity& entity, Core::RenderBatch* context)
+        : Component(entity), _context{ context }, _shape{ 0.f, 0.f, PADDLE_WIDTH, PADDLE_HEIGHT, Core::Colors::Red },
+        _origin{ PADDLE_WIDTH / 2.f, PADDLE_HEIGHT / 2.f } {}
+
+    CRectangle& CRectangle::Context(Core::RenderBatch* context)
+    {
+        _context = context;
+        return *this;
+    }
+
+    CRectangle& CRectangle::Color(Core::Color mColor)
+    {
+        _shape.color = mColor;
+        changed();
+        return *this;
+    }
 
-    CRectangle& CRectangle::Color(sf::Color mColor)
+    CRectangle& CRectangle::Size(const CMath::Vect2& size)
     {
-        _shape.setFillColor(mColor);
+        _shape.width = size.x;
+        _shape.height = size.y;
+        changed();
         return *this;
     }
 
-    CRectangle& CRectangle::Size(const CVect2& size)
+    CRectangle& CRectangle::Origin(const CMath::Vect2& origin)
     {
-        _shape.setSize(size);
+        _origin = origin;
+        _synced = 0;
+        changed();
         return *this;
     }
 
-    void CRectangle::Update(Frametime)
+    void CRectangle::sync() noexcept
     {
-        _shape.setPosition(_entity.getComponent<CPosition>().Get());
+        const CPosition& position = _entity.getComponent<CPosition>();
+        if (position.version() == _synced) return;
+
+        const CMath::Vect2 topLeft { toRender(position.Get()) - _origin };
+        _shape.left = topLeft.x;
+        _shape.top = topLeft.y;
+        _synced = position.version();
     }
 
     void CRectangle::Draw()
     {
-        _context->render(_shape);
+        sync();
+        _context->rectangles.push_back(_shape);
+    }
+
+    void CRectangle::Save(ByteStream& state) const
+    {
+        state.write(_shape.width);
+        state.write(_shape.height);
+        state.write(_shape.color);
+        state.write(_origin);
+    }
+
+    void CRectangle::Load(ByteStream& state)
+    {
+        state.read(_shape.width);
+        state.read(_shape.height);
+        state.read(_shape.color);
+        state.read(_origin);
+        _synced = 0;
+        changed();
     }
 
     CPaddleControl::CPaddleControl(Entity& entity)
         : Component(entity) {}
 
+    CPaddleControl& CPaddleControl::Direction(std::int8_t direction) noexcept
+    {
+        _direction = direction;
+        changed();
+        return *this;
+    }
+
     void CPaddleControl::Update(Frametime)
     {
         CPhysics& item = _entity.getComponent<CPhysics>();
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left) && item.left() > 0)
+        // note: bounds are checked every step, direction only change on command
+        if (_direction < 0 && item.left() > 0)
             item.Velocity({ -PADDLE_VELOCITY, item.Velocity().y });
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right) && item.right() < SCREEN_WIDTH)
+        else if (_direction > 0 && item.right() < Real(SCREEN_WIDTH))
             item.Velocity({ PADDLE_VELOCITY, item.Velocity().y });
-        else if (item.Velocity().x != 0.f)
+        else if (item.Velocity().x != Real{})
             item.Velocity({ {}, item.Velocity().y });
     }
-}
\ No newline at end of file
+
+    void CPaddleControl::Save(ByteStream& state) const
+    {
+        state.write(_direction);
+    }
+
+    void CPaddleControl::Load(ByteStream& state)
+    {
+        state.read(_direction);
+        changed();
+    }
+
+    CPowerUp::CPowerUp(Entity& entity, PowerUpType type)
+        : Component(entity), _type{ type } {}
+
+    CPowerUp& CPowerUp::Type(PowerUpType type) noexcept
+    {
+        _type = type;
+        changed();
+        return *this;
+    }
+
+    void CPowerUp::Save(ByteStream& state) const
+    {
+        state.write(_type);
+    }
+
+    void CPowerUp::Load(ByteStream& state)
+    {
+        state.read(_type);
+        changed();
+    }
+
+    CPaddlePower::CPaddlePower(Entity& entity)
+        : Component(entity) {}
+
+    void CPaddlePower::Save(ByteStream& state) const
+    {
+        state.write(_power);
+    }
+
+    void CPaddlePower::Load(ByteStream& state)
+    {
+        state.read(_power);
+        changed();
+    }
+
+    CBrick::CBrick(Entity& entity)
+        : Component(entity) {}
+
+    CBrick& CBrick::Type(BrickType type, std::uint8_t hits) noexcept
+    {
+        _state.type = type;
+        _state.hits = hits ? hits : static_cast<std::uint8_t>(type == BrickType::MultiHit ? MULTIHIT_HITS : 1);
+        changed();
+        return *this;
+    }
+
+    CBrick& CBrick::Color(Core::Color color) noexcept
+    {
+        _color = color;
+        changed();
+        return *this;
+    }
+
+    void CBrick::Save(ByteStream& state) const
+    {
+        state.write(_state);
+        state.write(_color);
+    }
+
+    void CBrick::Load(ByteStream& state)
+    {
+        state.read(_state);
+        state.read(_color);
+        changed();
+    }
+}
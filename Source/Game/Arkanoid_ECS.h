@@ -1,88 +1,239 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
 #include "Arkanoid_Global.h"
 #include "Component.h"
+#include "RenderBatch.h"
 
 using namespace ECS;
 
 namespace Arkanoid
 {
-    class Game;
-
 	class CPosition : public Component
 	{
 		CVect2 _position;
     public:
 		// we assume root position is the center of the shape
-        CPosition(Entity& entity, const CVect2& position);
+        CPosition(Entity& entity, const CVect2& position = {});
 
+        void Set(const CVect2& position) noexcept { _position = position; changed(); }
         void IncPos(const CVect2& dir);
         inline const CVect2& Get() const noexcept { return _position; }
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
 	};
 
     class CPhysics : public Component
 	{
 		CVect2 _velocity, _halfSize;
 
-        Vect2Callback _onOutOfBounds;
+        // moved and reflected on screen bounds by BoundsSystem
+        bool _bounce = false;
 
     public:
-		CPhysics(Entity& entity, const CVect2 &mHalfSize);
-
-		void Init() override;
+		CPhysics(Entity& entity, const CVect2 &mHalfSize = {});
 
+        CPhysics& HalfSize(const CVect2& halfSize);
         CPhysics& Velocity(const CVect2&& velocity);
-        CPhysics& Callback(Vect2Callback cb);
+        CPhysics& Bounce(bool bounce) noexcept;
 
         inline const CVect2& Velocity() const noexcept { return _velocity; }
+        inline const CVect2& HalfSize() const noexcept { return _halfSize; }
+        inline bool Bounce() const noexcept { return _bounce; }
 		void Update(Frametime ft) override;
-		inline const CVect2& Position() const noexcept;
+		const CVect2& Position() const noexcept;
+
+		Real left()		const noexcept;
+		Real right()	const noexcept;
+		Real top()		const noexcept;
+		Real bottom()	const noexcept;
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
+	};
+
+	// attached to a parent entity: position = parent position + local offset (written by HierarchySystem)
+	// note: parent is saved as its snapshot ordinal -> prefabs can't keep it, attach after instantiate
+	class CParent : public Component
+	{
+		Entity* _parent = nullptr;
+		CVect2 _local{};
+		// read by Load, resolved by Link
+		std::uint32_t _ordinal = 0;
+
+    public:
+		CParent(Entity& entity);
+
+		// nullptr -> detached, position is left where it is
+		CParent& Parent(Entity* parent) noexcept;
+		CParent& Local(const CVect2& local) noexcept;
+		inline Entity* Parent() const noexcept { return _parent; }
+		inline const CVect2& Local() const noexcept { return _local; }
 
-		float left()	const noexcept;
-		float right()	const noexcept;
-		float top()		const noexcept;
-		float bottom()	const noexcept;
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
+        void Link(const EntityList& entities) override;
 	};
 
 	class CCircle : public Component
 	{
 		// TODO: use DIP injection
-		Game* _context = {};
+		Core::RenderBatch* _context = {};
 
 		// define the composition itself
-		sf::CircleShape _shape;
+		Core::CircleInstance _shape{};
 		float _radius;
+		// position version copied in _shape
+		ECS::Version _synced = 0;
+
+		void sync() noexcept;
     public:
-		CCircle(Entity& entity, Game* context, float radius);
-		CCircle& Color(sf::Color mColor);
+		CCircle(Entity& entity, Core::RenderBatch* context = nullptr, float radius = BALL_RADIUS);
+		CCircle& Context(Core::RenderBatch* context);
+		CCircle& Color(Core::Color mColor);
 
-        void Init() override;
-		void Update(Frametime) override;
+		// note: shape is synced at draw and only if position changed (static entities cost nothing)
 		void Draw() override;
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
 	};
 
 	class CRectangle : public Component
 	{
 		// TODO: use DIP injection
-		Game* _context = {};
-		sf::RectangleShape _shape;
+		Core::RenderBatch* _context = {};
+		Core::RectangleInstance _shape{};
+		CMath::Vect2 _origin{};
+		// position version copied in _shape (reset when origin change)
+		ECS::Version _synced = 0;
+
+		void sync() noexcept;
 
     public:
-		CRectangle(Entity& entity, Game* context);
+		CRectangle(Entity& entity, Core::RenderBatch* context = nullptr);
 
-		CRectangle& Color(sf::Color mColor);
-		CRectangle& Size(const CVect2& size);
+		CRectangle& Context(Core::RenderBatch* context);
+		CRectangle& Color(Core::Color mColor);
+		CRectangle& Size(const CMath::Vect2& size);
+		CRectangle& Origin(const CMath::Vect2& origin);
+		inline CMath::Vect2 Size() const noexcept { return { _shape.width, _shape.height }; }
+		inline Core::Color Color() const noexcept { return _shape.color; }
 
-        void Init() override;
-        void Update(Frametime) override;
 		void Draw() override;
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
 	};
 
 	class CPaddleControl: public Component
 	{
+		// set by MovePaddle command: -1 left, 0 stop, 1 right
+		std::int8_t _direction = 0;
+
     public:
         CPaddleControl(Entity& entity);
+
+        CPaddleControl& Direction(std::int8_t direction) noexcept;
+        inline std::int8_t Direction() const noexcept { return _direction; }
+
 		void Update(Frametime) override;
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
+	};
+
+	enum class PowerUpType : std::uint8_t
+	{
+		Multiball,
+		WidePaddle,
+		Laser,
+
+		NB_TYPES
+	};
+
+	// falling capsule, applied when caught by a paddle
+	class CPowerUp : public Component
+	{
+		PowerUpType _type;
+
+    public:
+        CPowerUp(Entity& entity, PowerUpType type = PowerUpType::Multiball);
+
+        CPowerUp& Type(PowerUpType type) noexcept;
+        inline PowerUpType Type() const noexcept { return _type; }
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
+	};
+
+	// power ups active on a paddle, remaining times in ms (0 -> inactive)
+	struct PaddlePower
+	{
+		float wide;
+		float laser;
+		float laserCooldown;
+	};
+
+	class CPaddlePower : public Component
+	{
+		PaddlePower _power{};
+
+    public:
+        CPaddlePower(Entity& entity);
+
+        // note: mutable access counts as a change (timers are written through it)
+        inline PaddlePower& State() noexcept { changed(); return _power; }
+        inline const PaddlePower& State() const noexcept { return _power; }
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
+	};
+
+	// stored in LevelBrick::type
+	enum class BrickType : std::uint8_t
+	{
+		Normal,
+		MultiHit,
+		Indestructible,
+		// break its neighbours, chain with explosive ones
+		Explosive,
+
+		NB_TYPES
+	};
+
+	struct BrickState
+	{
+		BrickType type;
+		// remaining hits
+		std::uint8_t hits;
+	};
+
+	// note: damage is applied by DamageSystem after collisions, never during the pass
+	// note: no shape component, alive bricks are drawn by World from its brick field
+	class CBrick : public Component
+	{
+		BrickState _state{ BrickType::Normal, 1 };
+		Core::Color _color = Core::Colors::Yellow;
+		// slot in the brick field, set when indexed (not saved: the field is rebuilt on restore)
+		std::uint32_t _slot = 0xFFFFFFFFu;
+
+    public:
+        CBrick(Entity& entity);
+
+        inline std::uint32_t Slot() const noexcept { return _slot; }
+        // note: bookkeeping of the field, not brick state -> no version change
+        inline void Slot(std::uint32_t slot) noexcept { _slot = slot; }
+
+        // hits = 0 -> default of the type
+        CBrick& Type(BrickType type, std::uint8_t hits = 0) noexcept;
+        // note: mutable access counts as a change (damage is written through it)
+        inline BrickState& State() noexcept { changed(); return _state; }
+        inline const BrickState& State() const noexcept { return _state; }
+        CBrick& Color(Core::Color color) noexcept;
+        inline Core::Color Color() const noexcept { return _color; }
+
+        void Save(ByteStream& state) const override;
+        void Load(ByteStream& state) override;
 	};
-}
\ No newline at end of file
+}
@@ -1,19 +1,43 @@
 #pragma once
-#include <functional>
+#include "CMath.h"
 
 namespace Arkanoid
 {
+	class CPhysics;
+
 	constexpr unsigned int SCREEN_WIDTH{ 800 }, SCREEN_HEIGHT{ 600 };
 	constexpr float BALL_RADIUS{ 7.f }, BALL_VELOCITY{ 0.4f };
 	constexpr float PADDLE_WIDTH{ 80.f }, PADDLE_HEIGHT{ 20.f }, PADDLE_VELOCITY{ .6f };
 	constexpr float BLOCK_WIDTH{ 60.f }, BLOCK_HEIGHT{ 20.f };
 	constexpr int countBlocksX{ 11 }, countBlocksY{ 4 };
+	// brick lattice: center of cell (iX, iY) = ((iX + 1) * BRICK_PITCH_X + BRICK_OFFSET_X, (iY + 1) * BRICK_PITCH_Y)
+	constexpr float BRICK_PITCH_X{ BLOCK_WIDTH + 3.f }, BRICK_PITCH_Y{ BLOCK_HEIGHT + 3.f }, BRICK_OFFSET_X{ 22.f };
+	// hits of a multi hit brick when the level does not tell
+	constexpr unsigned int MULTIHIT_HITS{ 2 };
+
+	// power ups: one brick in POWERUP_DROP_RATE drop one, durations in ms
+	constexpr unsigned int POWERUP_DROP_RATE{ 6 };
+	constexpr float POWERUP_WIDTH{ 30.f }, POWERUP_HEIGHT{ 12.f }, POWERUP_VELOCITY{ .15f };
+	constexpr float WIDE_DURATION{ 10000.f }, WIDE_FACTOR{ 1.5f };
+	constexpr float LASER_DURATION{ 8000.f }, LASER_COOLDOWN{ 250.f };
+	constexpr float LASER_WIDTH{ 4.f }, LASER_HEIGHT{ 12.f }, LASER_VELOCITY{ .8f };
+	// laser turrets ride on the paddle edges while laser is active
+	constexpr float TURRET_WIDTH{ 8.f }, TURRET_HEIGHT{ 10.f };
+	// multiball split stop there
+	constexpr unsigned int MAX_BALLS{ 1024 };
 
 	// time base ref
 	constexpr float FT_STEP{ 1.f }, FT_SLICE{ 1.f };
 
 	using Frametime = float;
     using uint = unsigned int;
-    using CVect2 = sf::Vector2f;
-    using Vect2Callback = std::function<void(const CVect2&)>;
+
+	// physics scalar selected at compile time
+	// note: fixed point give bit exact simulation across machines (replay, lockstep)
+#ifdef ARKANOID_FIXED_PHYSICS
+	using Real = CMath::Fixed16;
+#else
+	using Real = float;
+#endif
+    using CVect2 = CMath::TVect2<Real>;
 }
\ No newline at end of file
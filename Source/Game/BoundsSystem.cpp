@@ -0,0 +1,121 @@
+#include "BoundsSystem.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+#include "Manager.h"
+
+#if defined(__AVX2__) && !defined(ARKANOID_FIXED_PHYSICS)
+#define ARKANOID_BOUNDS_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    static void integrateBounceScalar(std::size_t begin, std::size_t count, Real* x, Real* y, Real* vx, Real* vy,
+        const Real* hx, const Real* hy, Real ft, Real width, Real height)
+    {
+        for (std::size_t i { begin }; i < count; ++i)
+        {
+            x[i] = x[i] + vx[i] * ft;
+            y[i] = y[i] + vy[i] * ft;
+
+            vx[i] = reflect(vx[i], x[i], hx[i], width);
+            vy[i] = reflect(vy[i], y[i], hy[i], height);
+        }
+    }
+
+    void integrateBounce(std::size_t count, Real* x, Real* y, Real* vx, Real* vy,
+        const Real* hx, const Real* hy, Real ft, Real width, Real height)
+    {
+        std::size_t i { 0 };
+
+#ifdef ARKANOID_BOUNDS_AVX2
+        const __m256 vft { _mm256_set1_ps(ft) };
+        const __m256 zero { _mm256_setzero_ps() };
+        const __m256 vWidth { _mm256_set1_ps(width) }, vHeight { _mm256_set1_ps(height) };
+        const __m256 sign { _mm256_set1_ps(-0.f) };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            // note: mul then add (no fma) -> same result as the scalar path
+            const __m256 px { _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vft)) };
+            const __m256 py { _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), vft)) };
+            const __m256 ex { _mm256_loadu_ps(hx + i) }, ey { _mm256_loadu_ps(hy + i) };
+
+            __m256 velX { _mm256_loadu_ps(vx + i) }, velY { _mm256_loadu_ps(vy + i) };
+            const __m256 absX { _mm256_andnot_ps(sign, velX) }, absY { _mm256_andnot_ps(sign, velY) };
+
+            // right then left: left override -> same priority as scalar
+            velX = _mm256_blendv_ps(velX, _mm256_or_ps(sign, absX), _mm256_cmp_ps(_mm256_add_ps(px, ex), vWidth, _CMP_GT_OQ));
+            velX = _mm256_blendv_ps(velX, absX, _mm256_cmp_ps(_mm256_sub_ps(px, ex), zero, _CMP_LT_OQ));
+            velY = _mm256_blendv_ps(velY, _mm256_or_ps(sign, absY), _mm256_cmp_ps(_mm256_add_ps(py, ey), vHeight, _CMP_GT_OQ));
+            velY = _mm256_blendv_ps(velY, absY, _mm256_cmp_ps(_mm256_sub_ps(py, ey), zero, _CMP_LT_OQ));
+
+            _mm256_storeu_ps(x + i, px);
+            _mm256_storeu_ps(y + i, py);
+            _mm256_storeu_ps(vx + i, velX);
+            _mm256_storeu_ps(vy + i, velY);
+        }
+#endif
+
+        // tail of count % 8 bodies (or every body without AVX2 / with fixed point)
+        integrateBounceScalar(i, count, x, y, vx, vy, hx, hy, ft, width, height);
+    }
+
+    BoundsSystem::BoundsSystem(Manager& manager, Group group)
+        : _manager{ manager }, _group{ group }
+    {
+        auto bodies = [this](const EntityList& entities)
+        {
+            if (std::any_of(entities.begin(), entities.end(), [this](const Entity* entity) { return entity->hasGroup(_group); }))
+                ++_layout;
+        };
+        manager.onConstruct<CPhysics>(bodies);
+        manager.onDestroy<CPhysics>(bodies);
+    }
+
+    void BoundsSystem::Update(float ft)
+    {
+        gather();
+        integrateBounce(_bodies.size(), _x.data(), _y.data(), _vx.data(), _vy.data(), _hx.data(), _hy.data(),
+            Real(ft), Real(SCREEN_WIDTH), Real(SCREEN_HEIGHT));
+        scatter();
+    }
+
+    void BoundsSystem::gather()
+    {
+        _x.clear(); _y.clear();
+        _hx.clear(); _hy.clear();
+        _vx.clear(); _vy.clear();
+        _bodies.clear();
+        _positions.clear();
+
+        for (Entity* entity : _manager.getEntitiesByGroup(_group))
+        {
+            CPhysics& body = entity->getComponent<CPhysics>();
+            if (!body.Bounce()) continue;
+
+            CPosition& position = entity->getComponent<CPosition>();
+            _x.push_back(position.Get().x);
+            _y.push_back(position.Get().y);
+            _hx.push_back(body.HalfSize().x);
+            _hy.push_back(body.HalfSize().y);
+            _vx.push_back(body.Velocity().x);
+            _vy.push_back(body.Velocity().y);
+            _bodies.push_back(&body);
+            _positions.push_back(&position);
+        }
+    }
+
+    void BoundsSystem::scatter() const
+    {
+        for (std::size_t i { 0 }; i < _bodies.size(); ++i)
+        {
+            _positions[i]->Set(CVect2{ _x[i], _y[i] });
+            // note: most steps don't bounce -> velocity version only moves on a reflection
+            const CVect2 velocity { _vx[i], _vy[i] };
+            if (velocity != _bodies[i]->Velocity()) _bodies[i]->Velocity(CVect2{ velocity });
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "System.h"
+
+namespace ECS
+{
+    class Entity;
+}
+
+namespace Arkanoid
+{
+    class CPosition;
+
+    // Reflect velocity on [0, limit]: low side wins, velocity point back inside, position is not clamped
+    // note: |v| = max(v, -v), -|v| = min(v, -v) -> selects only, no branch
+    inline Real reflect(Real velocity, Real position, Real halfSize, Real limit) noexcept
+    {
+        const bool low { position - halfSize < Real{} };
+        const bool high { !low && position + halfSize > limit };
+
+        velocity = std::max(velocity, low ? -velocity : velocity);
+        return std::min(velocity, high ? -velocity : velocity);
+    }
+
+    // position += velocity * ft then reflect on [0, width] x [0, height]
+    // kernel over packed arrays, AVX2 when compiled for it (float only)
+    void integrateBounce(std::size_t count, Real* x, Real* y, Real* vx, Real* vy,
+        const Real* hx, const Real* hy, Real ft, Real width, Real height);
+
+    // Moves every body flagged CPhysics::Bounce in a group and reflect it on screen walls
+    // bodies are gathered in packed arrays, integrated in one vectorized pass, then written back
+    // note: CPhysics::Update skip these bodies
+    class BoundsSystem : public ECS::UpdateSystem
+    {
+        ECS::Manager& _manager;
+        ECS::Group _group;
+        // bumped when a body of the group is constructed or destroyed (seen at refresh)
+        std::uint32_t _layout = 0;
+
+        std::vector<Real> _x, _y, _hx, _hy, _vx, _vy;
+        std::vector<CPhysics*> _bodies;
+        std::vector<CPosition*> _positions;
+
+        void gather();
+        void scatter() const;
+
+    public:
+        BoundsSystem(ECS::Manager& manager, ECS::Group group);
+
+        void Update(float ft) override;
+
+        // bodies of the group, see BallLanes
+        ECS::Group group() const noexcept { return _group; }
+        std::uint32_t layout() const noexcept { return _layout; }
+    };
+}
@@ -0,0 +1,235 @@
+#include "BrickField.h"
+#include "Entity.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    // cell without brick
+    static constexpr std::uint32_t EMPTY { 0xFFFFFFFFu };
+
+    // cell of a point: cell (c, r) covers its center +- half a pitch
+    static int latticeColumn(float x)
+    {
+        return static_cast<int>(std::floor((x - BRICK_OFFSET_X) / BRICK_PITCH_X + .5f)) - 1;
+    }
+
+    static int latticeRow(float y)
+    {
+        return static_cast<int>(std::floor(y / BRICK_PITCH_Y + .5f)) - 1;
+    }
+
+    void BrickField::clear()
+    {
+        _cells.clear();
+        _offLattice.clear();
+        _left.clear(); _right.clear();
+        _top.clear(); _bottom.clear();
+        _entities.clear();
+        _states.clear();
+        _colors.clear();
+        _alive.clear();
+        _breakable.clear();
+        _columns = _rows = 0;
+        ++_version;
+    }
+
+    void BrickField::build(const EntityList& bricks)
+    {
+        clear();
+        insert(bricks);
+    }
+
+    void BrickField::insert(const EntityList& bricks)
+    {
+        const std::uint32_t first { static_cast<std::uint32_t>(_entities.size()) };
+
+        int minColumn { INT_MAX }, minRow { INT_MAX }, maxColumn { INT_MIN }, maxRow { INT_MIN };
+        for (Entity* brick : bricks)
+        {
+            if (!brick->isAlive()) continue;
+
+            const CPhysics& body = brick->getComponent<CPhysics>();
+            _left.push_back(body.left());
+            _right.push_back(body.right());
+            _top.push_back(body.top());
+            _bottom.push_back(body.bottom());
+            CBrick& data = brick->getComponent<CBrick>();
+            data.Slot(static_cast<std::uint32_t>(_entities.size()));
+            _entities.push_back(brick);
+            _states.push_back(static_cast<const CBrick&>(data).State());
+            _colors.push_back(data.Color());
+
+            const int column { latticeColumn(static_cast<float>(body.Position().x)) };
+            const int row { latticeRow(static_cast<float>(body.Position().y)) };
+            minColumn = std::min(minColumn, column); maxColumn = std::max(maxColumn, column);
+            minRow = std::min(minRow, row); maxRow = std::max(maxRow, row);
+        }
+
+        const std::uint32_t count { static_cast<std::uint32_t>(_entities.size()) };
+        if (count == first) return;
+
+        _alive.resize((count + 63) / 64, 0);
+        _breakable.resize(_alive.size(), 0);
+        for (std::uint32_t slot { first }; slot < count; ++slot)
+        {
+            _alive[slot >> 6] |= std::uint64_t{ 1 } << (slot & 63);
+            if (_states[slot].type != BrickType::Indestructible)
+                _breakable[slot >> 6] |= std::uint64_t{ 1 } << (slot & 63);
+        }
+        ++_version;
+
+        // new bricks inside the current lattice: only them are indexed
+        if (!_cells.empty() && minColumn >= _firstColumn && maxColumn < _firstColumn + _columns
+            && minRow >= _firstRow && maxRow < _firstRow + _rows)
+        {
+            for (std::uint32_t slot { first }; slot < count; ++slot)
+                index(slot);
+            return;
+        }
+
+        if (!_cells.empty())
+        {
+            minColumn = std::min(minColumn, _firstColumn); maxColumn = std::max(maxColumn, _firstColumn + _columns - 1);
+            minRow = std::min(minRow, _firstRow); maxRow = std::max(maxRow, _firstRow + _rows - 1);
+        }
+
+        _firstColumn = minColumn;
+        _firstRow = minRow;
+        _columns = maxColumn - minColumn + 1;
+        _rows = maxRow - minRow + 1;
+        _cells.assign(static_cast<std::size_t>(_columns) * _rows, EMPTY);
+        _offLattice.clear();
+
+        // note: dead slots are left out, they are only kept until the field is emptied
+        forEachAlive([this](std::uint32_t slot) { index(slot); });
+    }
+
+    void BrickField::index(std::uint32_t slot)
+    {
+        const Real x { (_left[slot] + _right[slot]) / Real(2) }, y { (_top[slot] + _bottom[slot]) / Real(2) };
+        int column, row;
+        cell(x, y, column, row);
+        std::uint32_t& entry { _cells[row * _columns + column] };
+
+        // note: one brick by cell, fully inside it -> a box only has to look at the cells it covers
+        const Real halfPitchX { BRICK_PITCH_X / 2.f }, halfPitchY { BRICK_PITCH_Y / 2.f };
+        const Real centerX { (column + _firstColumn + 1) * BRICK_PITCH_X + BRICK_OFFSET_X };
+        const Real centerY { (row + _firstRow + 1) * BRICK_PITCH_Y };
+        const bool inside { _left[slot] > centerX - halfPitchX && _right[slot] < centerX + halfPitchX
+            && _top[slot] > centerY - halfPitchY && _bottom[slot] < centerY + halfPitchY };
+
+        // a dead brick give its cell back
+        if (inside && (entry == EMPTY || !alive(entry)))
+            entry = slot;
+        else
+            _offLattice.push_back(slot);
+    }
+
+    void BrickField::remove(const EntityList& bricks)
+    {
+        std::uint32_t slot;
+        for (Entity* brick : bricks)
+            if (find(*brick, slot) && alive(slot)) kill(slot);
+
+        // board cleared (or replaced): slots are recycled
+        for (std::uint64_t word : _alive)
+            if (word) return;
+        clear();
+    }
+
+    bool BrickField::cell(Real x, Real y, int& column, int& row) const
+    {
+        column = latticeColumn(static_cast<float>(x)) - _firstColumn;
+        row = latticeRow(static_cast<float>(y)) - _firstRow;
+        return column >= 0 && column < _columns && row >= 0 && row < _rows;
+    }
+
+    void BrickField::query(Real left, Real top, Real right, Real bottom, std::vector<std::uint32_t>& slots) const
+    {
+        slots.clear();
+        if (_cells.empty()) return;
+
+        // covered cells, clamped to the board
+        int firstColumn, firstRow, lastColumn, lastRow;
+        cell(left, top, firstColumn, firstRow);
+        cell(right, bottom, lastColumn, lastRow);
+        firstColumn = std::max(firstColumn, 0); lastColumn = std::min(lastColumn, _columns - 1);
+        firstRow = std::max(firstRow, 0); lastRow = std::min(lastRow, _rows - 1);
+
+        auto test = [&](std::uint32_t slot)
+        {
+            if (alive(slot) && _right[slot] >= left && _left[slot] <= right && _bottom[slot] >= top && _top[slot] <= bottom)
+                slots.push_back(slot);
+        };
+
+        for (int row { firstRow }; row <= lastRow; ++row)
+            for (int column { firstColumn }; column <= lastColumn; ++column)
+            {
+                const std::uint32_t slot { _cells[row * _columns + column] };
+                if (slot != EMPTY) test(slot);
+            }
+
+        for (std::uint32_t slot : _offLattice)
+            test(slot);
+
+        // a handful of slots at most
+        std::sort(slots.begin(), slots.end());
+    }
+
+    void BrickField::neighbours(std::uint32_t slot, std::vector<std::uint32_t>& slots) const
+    {
+        slots.clear();
+
+        int column, row;
+        if (!cell((_left[slot] + _right[slot]) / Real(2), (_top[slot] + _bottom[slot]) / Real(2), column, row)) return;
+
+        for (int y { std::max(row - 1, 0) }; y <= std::min(row + 1, _rows - 1); ++y)
+            for (int x { std::max(column - 1, 0) }; x <= std::min(column + 1, _columns - 1); ++x)
+            {
+                const std::uint32_t neighbour { _cells[y * _columns + x] };
+                if (neighbour != EMPTY && neighbour != slot && alive(neighbour)) slots.push_back(neighbour);
+            }
+    }
+
+    bool BrickField::find(const Entity& brick, std::uint32_t& slot) const
+    {
+        // note: slots of destroyed bricks keep their entity address until the field is emptied,
+        // the pool can give it to a new brick -> slot comes from the brick, never from an address match
+        slot = brick.getComponent<CBrick>().Slot();
+        return slot < _entities.size() && _entities[slot] == &brick;
+    }
+
+    std::size_t BrickField::remaining() const noexcept
+    {
+        std::size_t count { 0 };
+        for (std::size_t word { 0 }; word < _alive.size(); ++word)
+            count += CMath::popcount(_alive[word] & _breakable[word]);
+
+        return count;
+    }
+
+    void BrickField::draw(Core::RenderBatch& batch)
+    {
+        if (_drawnVersion != _version)
+        {
+            _instances.clear();
+            forEachAlive([this](std::uint32_t slot)
+            {
+                // culling: big boards scroll out of the screen
+                if (_bottom[slot] < Real{} || _top[slot] > Real(SCREEN_HEIGHT) || _right[slot] < Real{} || _left[slot] > Real(SCREEN_WIDTH))
+                    return;
+
+                const float left { static_cast<float>(_left[slot]) }, top { static_cast<float>(_top[slot]) };
+                _instances.push_back(Core::RectangleInstance{ left, top,
+                    static_cast<float>(_right[slot]) - left, static_cast<float>(_bottom[slot]) - top, _colors[slot] });
+            });
+            _drawnVersion = _version;
+        }
+
+        batch.rectangles.insert(batch.rectangles.end(), _instances.begin(), _instances.end());
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Arkanoid_ECS.h"
+#include "ECS.h"
+
+namespace Arkanoid
+{
+    // Bricks of the board indexed by lattice cell (see BRICK_PITCH_X/Y)
+    // - a slot by brick, in board order: boxes, state and entity packed by slot
+    // - cell -> slot table: a box maps to the cells it covers with integer arithmetic (<= 4 for a ball)
+    // - alive slots are bits of a bitmap, cleared as soon as a brick is known to break
+    //   popcount give the bricks left, bit scan visit only alive ones (render)
+    // note: bricks off the lattice (not centered in their cell) are kept in a small list tested by brute force
+    class BrickField
+    {
+        int _firstColumn = 0, _firstRow = 0, _columns = 0, _rows = 0;
+        std::vector<std::uint32_t> _cells;
+        std::vector<std::uint32_t> _offLattice;
+
+        // by slot
+        std::vector<Real> _left, _right, _top, _bottom;
+        std::vector<ECS::Entity*> _entities;
+        std::vector<BrickState> _states;
+        std::vector<Core::Color> _colors;
+        std::vector<std::uint64_t> _alive;
+        // slots counted for level completion (not indestructible)
+        std::vector<std::uint64_t> _breakable;
+
+        // bumped on build and kill: drawn instances are rebuilt only when it moved
+        std::uint32_t _version = 0;
+        std::uint32_t _drawnVersion = 0;
+        std::vector<Core::RectangleInstance> _instances;
+
+        bool cell(Real x, Real y, int& column, int& row) const;
+        // cell (or off lattice) entry of a slot
+        void index(std::uint32_t slot);
+
+    public:
+        // rebuild from the brick group (restore)
+        void build(const ECS::EntityList& bricks);
+        void clear();
+        // append new bricks (construct hook), cells are only reindexed when the board grows
+        void insert(const ECS::EntityList& bricks);
+        // kill slots of destroyed bricks (destroy hook), field is emptied once no brick is left
+        void remove(const ECS::EntityList& bricks);
+
+        // alive slots overlapping the box, ascending (same order as a scan of the group)
+        void query(Real left, Real top, Real right, Real bottom, std::vector<std::uint32_t>& slots) const;
+        // alive slots of the 8 cells around a slot
+        void neighbours(std::uint32_t slot, std::vector<std::uint32_t>& slots) const;
+        // slot of a brick entity (see CBrick::Slot), false if not indexed
+        bool find(const ECS::Entity& brick, std::uint32_t& slot) const;
+
+        bool alive(std::uint32_t slot) const noexcept { return (_alive[slot >> 6] >> (slot & 63)) & 1u; }
+        void kill(std::uint32_t slot) noexcept
+        {
+            _alive[slot >> 6] &= ~(std::uint64_t{ 1 } << (slot & 63));
+            ++_version;
+        }
+
+        // alive bricks that can still be broken, level is complete at 0
+        std::size_t remaining() const noexcept;
+
+        // visit(slot) for each alive slot, ascending
+        template<typename F>
+        void forEachAlive(F&& visit) const
+        {
+            for (std::size_t word { 0 }; word < _alive.size(); ++word)
+                for (std::uint64_t bits { _alive[word] }; bits; bits &= bits - 1)
+                    visit(static_cast<std::uint32_t>(word * 64 + CMath::lowestBit(bits)));
+        }
+
+        // append alive bricks on screen
+        // note: bricks don't move, instances are cached until a brick is killed or the field rebuilt
+        void draw(Core::RenderBatch& batch);
+
+        std::size_t size() const noexcept { return _entities.size(); }
+        ECS::Entity& entity(std::uint32_t slot) const noexcept { return *_entities[slot]; }
+        // hits left once damage emitted in the current step is applied
+        BrickState& state(std::uint32_t slot) noexcept { return _states[slot]; }
+
+        Real left(std::uint32_t slot) const noexcept { return _left[slot]; }
+        Real right(std::uint32_t slot) const noexcept { return _right[slot]; }
+        Real top(std::uint32_t slot) const noexcept { return _top[slot]; }
+        Real bottom(std::uint32_t slot) const noexcept { return _bottom[slot]; }
+    };
+}
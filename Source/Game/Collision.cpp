@@ -0,0 +1,36 @@
+#include "Collision.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    void AabbSet::clear() noexcept
+    {
+        left.clear(); right.clear();
+        top.clear(); bottom.clear();
+        centerX.clear();
+        entities.clear();
+        alive.clear();
+    }
+
+    void AabbSet::gather(const EntityList& group)
+    {
+        clear();
+
+        for (Entity* entity : group)
+        {
+            if (!entity->isAlive()) continue;
+
+            const CPhysics& body = entity->getComponent<CPhysics>();
+            left.push_back(body.left());
+            right.push_back(body.right());
+            top.push_back(body.top());
+            bottom.push_back(body.bottom());
+            centerX.push_back(body.Position().x);
+            entities.push_back(entity);
+            alive.push_back(1);
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "ECS.h"
+
+namespace Arkanoid
+{
+    // AABBs of one group packed by side, gathered once per step
+    // note: pair tests only read these arrays, components are touched again only on response
+    struct AabbSet
+    {
+        std::vector<Real> left, right, top, bottom;
+        // horizontal center (paddle response)
+        std::vector<Real> centerX;
+        std::vector<ECS::Entity*> entities;
+        // cleared when the entity is destroyed during the pass
+        std::vector<std::uint8_t> alive;
+
+        void clear() noexcept;
+        // skip entities already destroyed (group not refreshed yet)
+        void gather(const ECS::EntityList& group);
+
+        std::size_t size() const noexcept { return entities.size(); }
+    };
+
+    // same rule as CMath::isIntersecting (touching counts)
+    inline bool intersects(const AabbSet& a, std::size_t i, const AabbSet& b, std::size_t j) noexcept
+    {
+        return a.right[i] >= b.left[j] && a.left[i] <= b.right[j] && a.bottom[i] >= b.top[j] && a.top[i] <= b.bottom[j];
+    }
+}
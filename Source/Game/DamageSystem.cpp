@@ -0,0 +1,63 @@
+#include "DamageSystem.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+#include "World.h"
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    DamageSystem::DamageSystem(World& world)
+        : _world{ world }
+    {}
+
+    void DamageSystem::Update(float)
+    {
+        _exploding.clear();
+
+        _events.execute([this](DamageEvent& event)
+        {
+            // note: several events can target the same brick in one step
+            if (!event.brick->isAlive()) return;
+
+            BrickState& state = event.brick->getComponent<CBrick>().State();
+            if (state.type == BrickType::Indestructible) return;
+
+            state.hits = event.damage < state.hits ? static_cast<std::uint8_t>(state.hits - event.damage) : 0;
+            if (state.hits > 0) return;
+
+            if (state.type == BrickType::Explosive) _exploding.push_back(event.brick);
+            _world.breakBrick(*event.brick);
+        });
+
+        if (!_exploding.empty()) explode();
+    }
+
+    void DamageSystem::explode()
+    {
+        BrickField& field = _world.bricks();
+
+        _queue.clear();
+        for (Entity* brick : _exploding)
+        {
+            std::uint32_t slot;
+            if (field.find(*brick, slot)) _queue.push_back(slot);
+        }
+
+        // breadth first: a wave of explosion by ring of neighbours
+        for (std::size_t next { 0 }; next < _queue.size(); ++next)
+        {
+            field.neighbours(_queue[next], _neighbours);
+            for (std::uint32_t slot : _neighbours)
+            {
+                Entity& brick = field.entity(slot);
+                BrickState& state = brick.getComponent<CBrick>().State();
+                if (state.type == BrickType::Indestructible) continue;
+
+                state.hits = 0;
+                _world.breakBrick(brick);
+                if (state.type == BrickType::Explosive) _queue.push_back(slot);
+            }
+        }
+    }
+}
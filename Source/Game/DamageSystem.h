@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "Command.h"
+#include "System.h"
+
+namespace ECS
+{
+    class Entity;
+}
+
+namespace Arkanoid
+{
+    class World;
+
+    // emitted by collisions, resolved in batch by DamageSystem
+    struct DamageEvent
+    {
+        ECS::Entity* brick;
+        std::uint8_t damage;
+    };
+
+    // Apply damage events of the step after the collision pass:
+    // - hits are removed, bricks without hits left are broken
+    // - explosive bricks break their 8 neighbours, chain through the brick field (BFS)
+    // note: entities are never destroyed while collisions iterate their groups
+    class DamageSystem : public ECS::UpdateSystem
+    {
+        World& _world;
+        Event::CommandBuffer<DamageEvent> _events;
+
+        // chain explosions: BFS over brick field slots (broken bricks are killed -> visited once)
+        std::vector<ECS::Entity*> _exploding;
+        std::vector<std::uint32_t> _queue;
+        std::vector<std::uint32_t> _neighbours;
+
+        void explode();
+
+    public:
+        explicit DamageSystem(World& world);
+
+        void push(ECS::Entity& brick, std::uint8_t damage = 1) { _events.push(DamageEvent{ &brick, damage }); }
+        void Update(float ft) override;
+        // pending events point to entities that may have been rebuilt (restore)
+        void clear() noexcept { _events.clear(); }
+    };
+}
@@ -1,220 +1,197 @@
 #include "Game.h"
-#include "Arkanoid_ECS.h"
-#include "System.h"
-#include "Entity.h"
-#include "CMath.h"
-
-using namespace ECS;
+#ifdef ARKANOID_SFML
+#include "SfmlLibrary.h"
+#endif
+#include <cmath>
+#include <iostream>
 
 namespace Arkanoid
 {
+#ifdef ARKANOID_SFML
     Game::Game()
-        : _window{ { SCREEN_WIDTH, SCREEN_HEIGHT }, "Arkanoid - components" }
+        : Game{ std::make_unique<Core::SfmlLibrary>() }
+    {
+    }
+#endif
+
+    Game::Game(std::unique_ptr<Core::Library> library)
+        : _library{ std::move(library) }, _world{ &_batch }
     {
-        // if fps are too slow, velocity process could skip collision
-        _window.setFramerateLimit(60);
+        _library->CreateWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Arkanoid - components");
+        _library->SetWorkers(&_workers);
+        _world.effects(&_particles);
+        _world.serve();
 
-        createPaddle();
-        createBall();
-        for (int iX{ 0 }; iX < countBlocksX; ++iX)
-            for (int iY{ 0 }; iY < countBlocksY; ++iY)
-                createBrick(sf::Vector2f{ (iX + 1) * (BLOCK_WIDTH + 3) + 22, (iY + 1) * (BLOCK_HEIGHT + 3) });
+        // note: frame rate is paced by _pacer (sleep + spin), not by the backend
 
         // TODO: create System
     }
+
+    Game::~Game()
+    {
+        _library->ReleaseWindow();
+    }
         
-    void Game::run()
+    bool Game::loadLevel(const std::string& path, std::uint32_t board)
+    {
+        if (!_levels.open(path)) 
+            return false;
+
+        if (board >= _levels.boardCount())
+        {
+            std::cerr << "Board " << board << " not found in " << path << std::endl;
+            return false;
+        }
+
+        _board = board;
+        _world.loadBoard(_levels.board(board));
+        _world.serve();
+        return true;
+    }
+
+    void Game::nextBoard()
+    {
+        if (_levels.boardCount() == 0)
+            _world.resetLevel();
+        else
+        {
+            _board = (_board + 1) % _levels.boardCount();
+            _world.loadBoard(_levels.board(_board));
+        }
+
+        _world.serve();
+    }
+
+    void Game::run(std::size_t maxFrames)
     {
         _running = true;
 
-        while (_running)
+        _pacer.start();
+
+        for (std::size_t frame { 0 }; _running && (maxFrames == 0 || frame < maxFrames); ++frame)
         {
-            auto timePoint1(std::chrono::high_resolution_clock::now());
-            _window.clear(sf::Color::Black);
+            _library->StartRender();
+            _library->ClearBackground();
 
             inputPhase();
             updatePhase();
             drawPhase();
 
-            auto timePoint2(std::chrono::high_resolution_clock::now());
-
-            auto elapseTime(timePoint2 - timePoint1);
-
-            Frametime ft{ std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(elapseTime).count() };
+            // note: present right on the frame boundary, frame time include the wait
+            Frametime ft{ _pacer.wait() };
+            _library->EndRender();
 
             _lastFt = ft;
 
             auto ftSeconds(ft / 1000.f);
             auto fps(1.f / ftSeconds);
 
-            _window.setTitle("FT: " + std::to_string(ft) + "\tFPS" + std::to_string(fps));
+            _library->SetTitle("FT: " + std::to_string(ft) + "\tFPS" + std::to_string(fps));
         }
     }
 
     void Game::inputPhase()
     {
-        // SFML tips: prevent window freezing
-        sf::Event event;
-        while (_window.pollEvent(event))
-        {
-            if (event.type == sf::Event::Closed)
-            {
-                _window.close();
-                break;
-            }
-        }
+        _library->RefreshInput();
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Escape)) _running = false;
-    }
+        if (!_library->IsWindowOpen() || Core::Library::KeyPressed(Core::Input::Escape)) _running = false;
 
-    void Game::updatePhase()
-    {
-        _currentSlice += _lastFt;
+        processSnapshotKeys();
 
-        // handle fixed FPS independent from CPU clock
-        // note : 
-        // if process took too much time --> execute several time the frame
-        // if process took too less time --> skip the frame
-        for (; _currentSlice >= FT_SLICE; _currentSlice -= FT_SLICE)
-        {
-            _manager.refresh();
-            // element must be update at fixed time to get precision
-            _manager.Update(FT_STEP);
-
-            EntityList& paddles = _manager.getEntitiesByGroup(GPaddle);
-            EntityList& bricks = _manager.getEntitiesByGroup(GBrick);
-            EntityList& balls = _manager.getEntitiesByGroup(GBall);
-
-            for (Entity* ball : balls)
-            {
-                for (Entity* paddle : paddles)
-                    processCollisionPB(*paddle, *ball);
-
-                for (Entity* brick : bricks)
-                    processCollisionBB(*brick, *ball);
-            }
-        }
+        if (_ai) emitAICommands();
+        else emitPlayerCommands();
     }
 
-    void Game::drawPhase()
+    void Game::timestep(const Timestep& timestep) noexcept
     {
-        _manager.Draw();
-        _window.display();
+        if (!timestep.valid()) return;
+
+        _timestep = timestep;
+        _currentSlice = 0.f;
     }
 
-    void Game::render(const sf::Drawable& drawable)
+    void Game::useAI(std::unique_ptr<PaddleBrain> brain)
     {
-        _window.draw(drawable);
+        _ai = std::make_unique<AIPaddleControl>(std::move(brain));
     }
 
-    Entity& Game::createBall()
+    void Game::emitAICommands()
     {
-        auto& entity = _manager.addEntity();
-
-        entity.addComponent<CPosition>(entity, sf::Vector2f{ SCREEN_WIDTH / 2.f, SCREEN_HEIGHT / 2.f });
-        entity.addComponent<CCircle>(entity, this, BALL_RADIUS).Color(sf::Color::White);
-        entity.addComponent<CPhysics>(entity, sf::Vector2f{ BALL_RADIUS, BALL_RADIUS })
-            .Velocity(sf::Vector2f{ -BALL_VELOCITY, -BALL_VELOCITY })
-            // we delegate collision process to Game 
-            .Callback([&entity](const sf::Vector2f& side)
-        {
-            CPhysics& cp{ entity.getComponent<CPhysics>() };
-            const CVect2& v = cp.Velocity();
-            if (side.x != 0.f)
-                cp.Velocity({abs(v.x) * side.x, v.y});
-
-            if (side.y != 0.f)
-                cp.Velocity({ v.x, abs(v.y) * side.y});
-        });
-
-        entity.addGroup(ArkanoidGroup::GBall);
-
-        return entity;
+        // note: AI never waits on a served ball
+        _world.launch();
+        _world.observe(*_ai);
+        _ai->decide();
     }
 
-    Entity& Game::createBrick(const sf::Vector2f& position)
+    void Game::emitPlayerCommands()
     {
-        sf::Vector2f _halfSize{ BLOCK_WIDTH / 2.f, BLOCK_HEIGHT / 2.f };
-        auto& entity = _manager.addEntity();
+        // rewind last paddle command
+        if (Core::Library::KeyTriggered(Core::Input::Backspace))
+            _world.commands().undo();
 
-        entity.addComponent<CPosition>(entity, position);
-        entity.addComponent<CPhysics>(entity, _halfSize);
-        entity.addComponent<CRectangle>(entity, this).Color(sf::Color::Yellow);
+        const std::int8_t direction = static_cast<std::int8_t>(
+            Core::Library::KeyPressed(Core::Input::Right) - Core::Library::KeyPressed(Core::Input::Left));
 
-        entity.addGroup(ArkanoidGroup::GBrick);
+        _world.movePaddles(direction);
 
-        return entity;
+        if (_autoLaunch || Core::Library::KeyTriggered(Core::Input::Space))
+            _world.launch();
     }
 
-    Entity& Game::createPaddle()
+    void Game::processSnapshotKeys()
     {
-        sf::Vector2f _halfSize{ PADDLE_WIDTH / 2.f, PADDLE_HEIGHT / 2.f };
-        auto& entity(_manager.addEntity());
-
-        entity.addComponent<CPosition>(entity, sf::Vector2f{ SCREEN_WIDTH / 2.f, SCREEN_HEIGHT - 60.f });
-        entity.addComponent<CPhysics>(entity, _halfSize);
-        entity.addComponent<CRectangle>(entity, this).Size({ PADDLE_WIDTH * 1.5f, PADDLE_HEIGHT * 0.5f });
-        entity.addComponent<CPaddleControl>(entity);
+        // reset level
+        if (Core::Library::KeyTriggered(Core::Input::R))
+        {
+            _world.resetLevel();
+            _world.serve();
+        }
 
-        entity.addGroup(ArkanoidGroup::GPaddle);
+        // quick save
+        if (Core::Library::KeyTriggered(Core::Input::F5))
+            _world.save(_quickSave); 
 
-        return entity;
+        // quick load
+        if (Core::Library::KeyTriggered(Core::Input::F9) && !_quickSave.empty())
+            _world.restore(_quickSave);
     }
 
-    System& Game::createSystem()
+    void Game::updatePhase()
     {
-        sf::Vector2f _halfSize{ PADDLE_WIDTH / 2.f, PADDLE_HEIGHT / 2.f };
-        auto& entity = _manager.addSystem<ECS::UpdateSystem>();
+        _currentSlice += _lastFt;
 
-        return entity;
-    }
+        // commands emitted this frame are applied once, before the fixed steps
+        _world.executeCommands();
 
-    void Game::processCollisionPB(Entity& paddle, Entity& ball)
-    {
-        CPhysics& cpBall = ball.getComponent<CPhysics>();
-        CPhysics& cpPaddle = paddle.getComponent<CPhysics>();
+        // handle fixed FPS independent from CPU clock
+        // note : 
+        // if process took too much time --> execute several time the frame
+        // if process took too less time --> skip the frame
+        const Frametime step{ _timestep.step() };
+        std::size_t substeps{ 0 };
 
-        const CVect2& vBall = cpBall.Velocity();
-        const CVect2& vPaddle = cpPaddle.Velocity();
+        if (!_timestep.refreshEachStep) _world.refresh();
 
-        const CVect2& pBall = cpBall.Position();
-        const CVect2& pPaddle = cpPaddle.Position();
+        // cosmetic: integrated once per frame with frame time
+        _particles.update(_lastFt);
 
-        if (!CMath::isIntersecting(cpPaddle, cpBall)) 
-            return;
+        for (; _currentSlice >= step && substeps < _timestep.maxSubsteps; _currentSlice -= step, ++substeps)
+            _world.step(step, _timestep.refreshEachStep);
 
-        if (pBall.x < pPaddle.x)
-            cpBall.Velocity({ -BALL_VELOCITY, -BALL_VELOCITY });
-        else 
-            cpBall.Velocity({ BALL_VELOCITY, -BALL_VELOCITY });
+        // after a hitch: drop the late time, game slow down instead of looping hundreds of steps
+        if (substeps == _timestep.maxSubsteps && _currentSlice >= step)
+            _currentSlice = std::fmod(_currentSlice, step);
 
+        // note: popcount of the brick bitmap, cheap enough to test every frame
+        if (_world.levelComplete()) nextBoard();
     }
 
-    void Game::processCollisionBB(Entity& brick, Entity& ball)
+    void Game::drawPhase()
     {
-        auto& cpBall = ball.getComponent<CPhysics>();
-        auto& cpBrick = brick.getComponent<CPhysics>();
-
-        if (!CMath::isIntersecting(cpBrick, cpBall)) return;
-
-        brick.destroy();
-
-        // test collision scenario to deduce reaction
-        float overlapLeft = cpBall.right() - cpBrick.left();
-        float overlapRight = cpBrick.right() - cpBall.left();
-        float overlapTop = cpBall.bottom() - cpBrick.top();
-        float overlapBottom = cpBrick.bottom() - cpBall.top();
-
-        bool BallFromLeft = abs(overlapLeft) < abs(overlapRight);
-        bool BallFromTop = abs(overlapTop) < abs(overlapBottom);
-
-        float minOverlapX = BallFromLeft ? overlapLeft : overlapRight;
-        float minOverlapY = BallFromTop ? overlapTop : overlapBottom;
-
-        // deduce if ball repel horizontally or vertically
-        if (abs(minOverlapX) < abs(minOverlapY))
-            cpBall.Velocity({BallFromLeft ? -BALL_VELOCITY : BALL_VELOCITY, cpBall.Velocity().y});
-        else
-            cpBall.Velocity({ cpBall.Velocity().x, BallFromTop ? -BALL_VELOCITY : BALL_VELOCITY});
+        // components fill the batch, backend draw it by shape type
+        _batch.clear();
+        _world.draw();
+        _particles.draw(_batch, &_workers);
+        _batch.submit(*_library);
     }
-}
\ No newline at end of file
+}
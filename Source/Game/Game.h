@@ -1,48 +1,108 @@
 #pragma once
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <cmath>
+#include <memory>
 #include "Arkanoid_Global.h"
-#include "Manager.h"
-
-using namespace ECS;
-namespace ECS {
-    class Entity;
-    class System;
-}
+#include "AIPaddleControl.h"
+#include "World.h"
+#include "Level.h"
+#include "FramePacer.h"
+#include "Library.h"
+#include "Particles.h"
+#include "RenderBatch.h"
+#include "ThreadPool.h"
 
 namespace Arkanoid
 {
+    // slowest simulation accepted: one step by second (1000 ms step)
+    constexpr float MIN_TICK_RATE { 1.f };
+
+    // fixed timestep settings
+    struct Timestep
+    {
+        // simulation ticks by second (default: legacy 1 ms step)
+        float tickRate = 1000.f / FT_STEP;
+        // steps by frame before the simulation slows down instead of catching up (spiral of death)
+        std::size_t maxSubsteps = 64;
+        // false -> destroyed entities are removed once per frame instead of every step
+        bool refreshEachStep = true;
+
+        // false for a rate below MIN_TICK_RATE, NaN or infinite (step would be huge, negative or zero)
+        // or without substep (no step would ever run, late time would be dropped)
+        bool valid() const noexcept { return tickRate >= MIN_TICK_RATE && std::isfinite(tickRate) && maxSubsteps > 0; }
+        Frametime step() const noexcept { return 1000.f / tickRate; }
+    };
+
     class Game
     {
-        // we define group to accelerate testing
-        enum ArkanoidGroup : uint
-        {
-            GPaddle,
-            GBrick,
-            GBall
-        };
-
-        sf::RenderWindow _window;
+        // render side jobs (vertex and instance generation)
+        // note: declared first, backend keep a pointer on it
+        Core::ThreadPool _workers;
+
+        // platform backend (window, input, render)
+        std::unique_ptr<Core::Library> _library;
+        Core::RenderBatch _batch;
         Frametime _lastFt = 0.f;
         Frametime _currentSlice = 0.f;
         bool _running = false;
-        Manager _manager;
+        Timestep _timestep;
+        // if fps are too slow, velocity process could skip collision
+        Core::FramePacer _pacer{ 60. };
+
+        // brick break effects, drawn in the same batch
+        ParticleSystem _particles;
+
+        // note: declared after _batch, world components draw into it
+        World _world;
+
+        // quick save (F5/F9)
+        Snapshot _quickSave;
 
-        void processCollisionPB(Entity& paddle, Entity& ball);
-        void processCollisionBB(Entity& brick, Entity& ball);
+        // keep pack mapped: boards are read in place
+        LevelPack _levels;
+        std::uint32_t _board = 0;
+
+        // replace player input when set
+        std::unique_ptr<AIPaddleControl> _ai;
+        // nobody to press Space (headless run): served balls leave at once
+        bool _autoLaunch = false;
+
+        void processSnapshotKeys();
+        void emitPlayerCommands();
+        void emitAICommands();
+
+        // board cleared: next board of the pack (or same board again)
+        void nextBoard();
 
         void inputPhase();
         void updatePhase();
         void drawPhase();
     public:
-        // factory
-        Entity& createBall();
-        Entity& createBrick(const sf::Vector2f& position);
-        Entity& createPaddle();
-        System& createSystem();
-
+#ifdef ARKANOID_SFML
+        // default to SFML backend
         Game();
+#endif
+        explicit Game(std::unique_ptr<Core::Library> library);
+        ~Game();
+
+        // replace current bricks by a board from a binary level pack
+        bool loadLevel(const std::string& path, std::uint32_t board);
 
-        void run();
-        void render(const sf::Drawable& drawable);
+        // note: invalid settings (see Timestep::valid) keep the current ones
+        void timestep(const Timestep& timestep) noexcept;
+        const Timestep& timestep() const noexcept { return _timestep; }
+
+        // 0 -> unlimited
+        void framerate(double rate) { _pacer.Rate(rate); }
+        const Core::PacingStats& pacing() const noexcept { return _pacer.Stats(); }
+
+        // paddle driven by a brain instead of keyboard (nullptr -> TrackingBrain)
+        void useAI(std::unique_ptr<PaddleBrain> brain = nullptr);
+        // launch served balls without waiting on player input (AI always does)
+        void autoLaunch(bool enabled) noexcept { _autoLaunch = enabled; }
+
+        // maxFrames = 0 -> run until window close or escape
+        void run(std::size_t maxFrames = 0);
+
+        World& world() noexcept { return _world; }
     };
-}
\ No newline at end of file
+}
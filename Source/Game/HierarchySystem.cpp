@@ -0,0 +1,125 @@
+#include "HierarchySystem.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+#include "Manager.h"
+#include <algorithm>
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    // parent node of a root parent (not attached itself)
+    static constexpr std::uint32_t ROOT { 0xFFFFFFFFu };
+
+    HierarchySystem::HierarchySystem(Manager& manager)
+    {
+        // note: hooks fire at refresh -> nodes are sorted at most once by sync point
+        manager.onConstruct<CParent>([this](const EntityList& entities) { add(entities); });
+        manager.onDestroy<CParent>([this](const EntityList&) { remove(); });
+        // any destroyed entity can be a parent
+        manager.onDestroy<CPosition>([this](const EntityList&) { cascade(); });
+    }
+
+    void HierarchySystem::add(const EntityList& entities)
+    {
+        for (Entity* entity : entities)
+            _links.push_back(Attachment{ entity, &entity->getComponent<CParent>(), 0 });
+
+        sort();
+    }
+
+    void HierarchySystem::remove()
+    {
+        _links.erase(std::remove_if(_links.begin(), _links.end(), [](const Attachment& link) { return !link.entity->isAlive(); }),
+            _links.end());
+
+        sort();
+    }
+
+    void HierarchySystem::cascade()
+    {
+        bool orphans { false };
+        for (const Attachment& link : _links)
+        {
+            const Entity* parent { link.parent->Parent() };
+            if (link.entity->isAlive() && parent && !parent->isAlive())
+            {
+                link.entity->destroy();
+                orphans = true;
+            }
+        }
+
+        // note: nodes must not keep destroyed parents, they are released at the end of this refresh
+        if (orphans) sort();
+    }
+
+    void HierarchySystem::sort()
+    {
+        _order.clear();
+        for (std::uint32_t i { 0 }; i < _links.size(); ++i)
+        {
+            Attachment& link { _links[i] };
+            link.version = link.parent->version();
+            if (!link.entity->isAlive() || !link.parent->Parent()) continue;
+
+            // depth = attached ancestors, walked once by structural change
+            std::uint32_t depth { 0 };
+            for (const Entity* parent { link.parent->Parent() };
+                parent->hasComponent<CParent>() && parent->getComponent<CParent>().Parent();
+                parent = parent->getComponent<CParent>().Parent())
+            {
+                assert(depth < _links.size() && "CParent cycle");
+                ++depth;
+            }
+
+            _order.emplace_back(depth, i);
+        }
+        std::sort(_order.begin(), _order.end());
+
+        _nodes.clear();
+        for (std::uint32_t node { 0 }; node < _order.size(); ++node)
+            _nodes.emplace_back(_links[_order[node].second].entity, node);
+        std::sort(_nodes.begin(), _nodes.end());
+
+        _parentNodes.clear();
+        _rootPositions.clear();
+        _positions.clear();
+        _local.clear();
+        _world.clear();
+
+        for (const auto& entry : _order)
+        {
+            const Attachment& link { _links[entry.second] };
+            const Entity* parent { link.parent->Parent() };
+
+            const auto found = std::lower_bound(_nodes.begin(), _nodes.end(), std::make_pair(parent, std::uint32_t{ 0 }));
+            const bool attached { found != _nodes.end() && found->first == parent };
+
+            _parentNodes.push_back(attached ? found->second : ROOT);
+            _rootPositions.push_back(attached ? nullptr : &parent->getComponent<CPosition>());
+            _positions.push_back(&link.entity->getComponent<CPosition>());
+            _local.push_back(link.parent->Local());
+            _world.emplace_back();
+        }
+    }
+
+    void HierarchySystem::Update(float)
+    {
+        // setters and snapshot load bump the version
+        for (const Attachment& link : _links)
+        {
+            if (link.parent->version() != link.version)
+            {
+                sort();
+                break;
+            }
+        }
+
+        for (std::size_t node { 0 }; node < _positions.size(); ++node)
+        {
+            const std::uint32_t parent { _parentNodes[node] };
+            _world[node] = (parent == ROOT ? _rootPositions[node]->Get() : _world[parent]) + _local[node];
+            _positions[node]->Set(_world[node]);
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "Component.h"
+#include "ECS.h"
+#include "System.h"
+
+namespace Arkanoid
+{
+    class CParent;
+    class CPosition;
+
+    // Moves attached entities (CParent) with their parent in one linear pass, no recursion
+    // - nodes are packed in flat arrays sorted by depth: a parent world position is always computed before its children
+    // - a root parent (not attached itself) is read from its CPosition, others from the world array
+    // - arrays are only rebuilt on structural change (attach, detach, local offset, destroy), not every step
+    // note: children are destroyed with their parent
+    class HierarchySystem : public ECS::UpdateSystem
+    {
+        struct Attachment
+        {
+            ECS::Entity* entity;
+            CParent* parent;
+            // CParent version used by the last sort
+            ECS::Version version;
+        };
+
+        // entities owning a CParent (attached or not), kept by construct/destroy hooks
+        std::vector<Attachment> _links;
+
+        // by node, depth ascending
+        std::vector<std::uint32_t> _parentNodes;
+        std::vector<const CPosition*> _rootPositions;
+        std::vector<CPosition*> _positions;
+        std::vector<CVect2> _local, _world;
+
+        // sort scratch: (depth, attachment) then (entity, node) to find the node of a parent
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> _order;
+        std::vector<std::pair<const ECS::Entity*, std::uint32_t>> _nodes;
+
+        void add(const ECS::EntityList& entities);
+        void remove();
+        // destroy children of destroyed entities (and theirs, reported again by the manager)
+        void cascade();
+        void sort();
+
+    public:
+        explicit HierarchySystem(ECS::Manager& manager);
+
+        // world position = parent world position + local, written in CPosition
+        void Update(float ft) override;
+
+        // attached entities
+        std::size_t size() const noexcept { return _positions.size(); }
+    };
+}
@@ -0,0 +1,192 @@
+#include "Level.h"
+
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "Arkanoid_ECS.h"
+
+namespace Arkanoid
+{
+    bool LevelPack::open(const std::string& path)
+    {
+        close();
+
+        if (!_file.open(path))
+        {
+            std::cerr << "Cannot map level pack: " << path << std::endl;
+            return false;
+        }
+
+        const std::uint8_t* data { _file.data() };
+        const std::size_t size { _file.size() };
+
+        const auto* header = reinterpret_cast<const LevelHeader*>(data);
+        if (size < sizeof(LevelHeader) || header->magic != LEVEL_MAGIC || header->version != LEVEL_VERSION)
+        {
+            std::cerr << "Invalid level pack: " << path << std::endl;
+            close();
+            return false;
+        }
+
+        const std::size_t boardsOffset { sizeof(LevelHeader) };
+        const std::size_t bricksOffset { boardsOffset + header->boardCount * sizeof(LevelBoardEntry) };
+        if (size < bricksOffset + header->brickCount * sizeof(LevelBrick))
+        {
+            std::cerr << "Truncated level pack: " << path << std::endl;
+            close();
+            return false;
+        }
+
+        _header = header;
+        _boards = reinterpret_cast<const LevelBoardEntry*>(data + boardsOffset);
+        _bricks = reinterpret_cast<const LevelBrick*>(data + bricksOffset);
+
+        for (std::uint32_t i { 0 }; i < header->boardCount; ++i)
+        {
+            // note: no sum -> a crafted first + count can't wrap around and pass
+            const LevelBoardEntry& entry { _boards[i] };
+            if (entry.firstBrick > header->brickCount || entry.brickCount > header->brickCount - entry.firstBrick)
+            {
+                std::cerr << "Corrupted board " << i << " in level pack: " << path << std::endl;
+                close();
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void LevelPack::close()
+    {
+        _file.close();
+        _header = nullptr;
+        _boards = nullptr;
+        _bricks = nullptr;
+    }
+
+    LevelBoard LevelPack::board(std::uint32_t index) const noexcept
+    {
+        assert(index < boardCount());
+        return { _bricks + _boards[index].firstBrick, _boards[index].brickCount };
+    }
+
+    static bool cellColor(char cell, std::uint32_t& color)
+    {
+        switch (cell)
+        {
+        case 'Y': color = 0xFFFF00FF; return true;
+        case 'R': color = 0xFF0000FF; return true;
+        case 'G': color = 0x00FF00FF; return true;
+        case 'B': color = 0x0000FFFF; return true;
+        case 'C': color = 0x00FFFFFF; return true;
+        case 'M': color = 0xFF00FFFF; return true;
+        case 'W': color = 0xFFFFFFFF; return true;
+        case 'O': color = 0xFF8000FF; return true;
+        default: return false;
+        }
+    }
+
+    static bool cellBrick(char cell, LevelBrick& brick)
+    {
+        if (cellColor(cell, brick.color)) return true;
+
+        if (cell >= '2' && cell <= '9')
+        {
+            brick.type = static_cast<std::uint8_t>(BrickType::MultiHit);
+            brick.hits = static_cast<std::uint8_t>(cell - '0');
+            brick.color = 0xC0C0C0FF;
+            return true;
+        }
+
+        switch (cell)
+        {
+        case '=': brick.type = static_cast<std::uint8_t>(BrickType::Indestructible); brick.color = 0x707070FF; return true;
+        case '*': brick.type = static_cast<std::uint8_t>(BrickType::Explosive); brick.color = 0xFF4000FF; return true;
+        default: return false;
+        }
+    }
+
+    bool compileLevels(const std::string& textPath, const std::string& binaryPath)
+    {
+        std::ifstream input{ textPath };
+        if (!input)
+        {
+            std::cerr << "Cannot read level source: " << textPath << std::endl;
+            return false;
+        }
+
+        std::vector<LevelBoardEntry> boards;
+        std::vector<LevelBrick> bricks;
+
+        std::string line;
+        int lineNumber { 0 };
+        int row { -1 }; // -1 -> outside of a board
+
+        while (std::getline(input, line))
+        {
+            ++lineNumber;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty() || line[0] == '#') continue;
+
+            if (line == "board")
+            {
+                boards.push_back({ static_cast<std::uint32_t>(bricks.size()), 0 });
+                row = 0;
+                continue;
+            }
+
+            if (line == "end")
+            {
+                row = -1;
+                continue;
+            }
+
+            if (row < 0)
+            {
+                std::cerr << textPath << "(" << lineNumber << "): row outside of a board" << std::endl;
+                return false;
+            }
+
+            for (std::size_t column { 0 }; column < line.size(); ++column)
+            {
+                const char cell { line[column] };
+                if (cell == '.' || cell == ' ') continue;
+
+                LevelBrick brick {};
+                if (!cellBrick(cell, brick))
+                {
+                    std::cerr << textPath << "(" << lineNumber << "): unknown brick '" << cell << "'" << std::endl;
+                    return false;
+                }
+
+                // same lattice as the classic board
+                brick.x = (column + 1) * BRICK_PITCH_X + BRICK_OFFSET_X;
+                brick.y = (row + 1) * BRICK_PITCH_Y;
+                bricks.push_back(brick);
+                ++boards.back().brickCount;
+            }
+
+            ++row;
+        }
+
+        return writeLevelPack(binaryPath, boards, bricks);
+    }
+
+    bool writeLevelPack(const std::string& binaryPath, const std::vector<LevelBoardEntry>& boards, const std::vector<LevelBrick>& bricks)
+    {
+        std::ofstream output{ binaryPath, std::ios::binary };
+        if (!output)
+        {
+            std::cerr << "Cannot write level pack: " << binaryPath << std::endl;
+            return false;
+        }
+
+        const LevelHeader header { LEVEL_MAGIC, LEVEL_VERSION, static_cast<std::uint32_t>(boards.size()), static_cast<std::uint32_t>(bricks.size()) };
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(reinterpret_cast<const char*>(boards.data()), boards.size() * sizeof(LevelBoardEntry));
+        output.write(reinterpret_cast<const char*>(bricks.data()), bricks.size() * sizeof(LevelBrick));
+
+        return static_cast<bool>(output);
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "MappedFile.h"
+
+namespace Arkanoid
+{
+    // Binary level pack (.lvl), native endianness:
+    // [LevelHeader][LevelBoardEntry x boardCount][LevelBrick x total bricks]
+    // note: file is memory mapped and bricks are read in place
+    constexpr std::uint32_t LEVEL_MAGIC{ 0x4C4B5241 }; // "ARKL"
+    constexpr std::uint32_t LEVEL_VERSION{ 1 };
+
+    struct LevelHeader
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t boardCount;
+        std::uint32_t brickCount;
+    };
+
+    struct LevelBoardEntry
+    {
+        std::uint32_t firstBrick;
+        std::uint32_t brickCount;
+    };
+
+    struct LevelBrick
+    {
+        float x, y;
+        std::uint32_t color; // RGBA (Core::Color)
+        std::uint8_t type;   // BrickType
+        std::uint8_t hits;   // 0 -> default of the type
+        std::uint8_t padding[2];
+    };
+
+    static_assert(sizeof(LevelHeader) == 16, "LevelHeader layout changed");
+    static_assert(sizeof(LevelBoardEntry) == 8, "LevelBoardEntry layout changed");
+    static_assert(sizeof(LevelBrick) == 16, "LevelBrick layout changed");
+    static_assert(std::is_trivially_copyable<LevelBrick>::value, "LevelBrick must be POD");
+
+    // view on one board of a pack
+    struct LevelBoard
+    {
+        const LevelBrick* bricks = nullptr;
+        std::uint32_t count = 0;
+
+        const LevelBrick* begin() const noexcept { return bricks; }
+        const LevelBrick* end() const noexcept { return bricks + count; }
+    };
+
+    class LevelPack
+    {
+        Core::MappedFile _file;
+        const LevelHeader* _header = nullptr;
+        const LevelBoardEntry* _boards = nullptr;
+        const LevelBrick* _bricks = nullptr;
+
+    public:
+        bool open(const std::string& path);
+        void close();
+
+        std::uint32_t boardCount() const noexcept { return _header ? _header->boardCount : 0; }
+        LevelBoard board(std::uint32_t index) const noexcept;
+    };
+
+    // boards index bricks as [firstBrick, firstBrick + brickCount)
+    bool writeLevelPack(const std::string& binaryPath, const std::vector<LevelBoardEntry>& boards, const std::vector<LevelBrick>& bricks);
+
+    // Text authoring format -> binary pack
+    // - '#' start a comment line
+    // - "board" start a board, "end" close it
+    // - each row is one line of cells: '.' or ' ' is empty, a letter is a brick colour
+    //   (Y yellow, R red, G green, B blue, C cyan, M magenta, W white, O orange)
+    //   or a special brick: '2'..'9' multi hit (hits count), '=' indestructible, '*' explosive
+    bool compileLevels(const std::string& textPath, const std::string& binaryPath);
+}
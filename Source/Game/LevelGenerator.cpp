@@ -0,0 +1,147 @@
+#include "LevelGenerator.h"
+#include "Arkanoid_ECS.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace Arkanoid
+{
+    namespace
+    {
+        // splitmix64: decorrelated streams from consecutive seeds
+        struct Random
+        {
+            std::uint64_t state;
+
+            std::uint64_t next() noexcept
+            {
+                std::uint64_t z { state += 0x9E3779B97F4A7C15ull };
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                return z ^ (z >> 31);
+            }
+
+            // [0, 1)
+            float uniform() noexcept { return static_cast<float>(next() >> 40) / static_cast<float>(1 << 24); }
+            std::uint32_t below(std::uint32_t bound) noexcept { return static_cast<std::uint32_t>(next() % bound); }
+        };
+
+        constexpr std::uint32_t palette[] { 0xFFFF00FF, 0xFF0000FF, 0x00FF00FF, 0x0000FFFF, 0x00FFFFFF, 0xFF00FFFF, 0xFFFFFFFF, 0xFF8000FF };
+        constexpr std::uint32_t paletteSize { sizeof(palette) / sizeof(palette[0]) };
+
+        // boards of one parallel range are generated in their own buffers
+        constexpr std::size_t BOARD_GRAIN { 16 };
+    }
+
+    LevelGenerator::LevelGenerator(const GeneratorSettings& settings)
+        : _settings{ settings }
+    {}
+
+    void LevelGenerator::generate(std::uint64_t seed, std::uint32_t index, std::vector<LevelBrick>& bricks) const
+    {
+        Random random { seed ^ (static_cast<std::uint64_t>(index) * 0xD1B54A32D192ED03ull) };
+        random.next();
+
+        const std::uint32_t columns { std::max(_settings.columns, 1u) }, rows { std::max(_settings.rows, 1u) };
+        const BoardPattern pattern { static_cast<BoardPattern>(random.below((std::uint32_t)BoardPattern::NB_PATTERNS)) };
+        const std::uint32_t colorOffset { random.below(paletteSize) };
+        const std::uint32_t period { 2 + random.below(2) };
+
+        // mirror: right half copy the left half decisions
+        std::vector<std::uint8_t> filled(columns);
+
+        for (std::uint32_t row { 0 }; row < rows; ++row)
+        {
+            const float curve { rows > 1 ? static_cast<float>(row) / (rows - 1) : 0.f };
+            const float density { _settings.density * (1.f - _settings.falloff * curve) };
+
+            for (std::uint32_t column { 0 }; column < columns; ++column)
+            {
+                bool fill { random.uniform() < density };
+                switch (pattern)
+                {
+                case BoardPattern::Mirror:
+                    if (column >= (columns + 1) / 2) fill = filled[columns - 1 - column] != 0;
+                    break;
+                case BoardPattern::Stripes:
+                    fill = fill && row % period != period - 1;
+                    break;
+                case BoardPattern::Pyramid:
+                {
+                    const int fromCenter { std::abs(static_cast<int>(2 * column) - static_cast<int>(columns - 1)) / 2 };
+                    fill = fill && fromCenter <= static_cast<int>(row);
+                    break;
+                }
+                case BoardPattern::Checker:
+                    fill = fill && (row + column) % 2 == 0;
+                    break;
+                default:
+                    break;
+                }
+                filled[column] = fill;
+                if (!fill) continue;
+
+                LevelBrick brick {};
+                brick.x = (column + 1) * BRICK_PITCH_X + BRICK_OFFSET_X;
+                brick.y = (row + 1) * BRICK_PITCH_Y;
+                brick.color = palette[(row + colorOffset) % paletteSize];
+
+                const float kind { random.uniform() };
+                if (kind < _settings.indestructibleRate)
+                {
+                    brick.type = static_cast<std::uint8_t>(BrickType::Indestructible);
+                    brick.color = 0x707070FF;
+                }
+                else if (kind < _settings.indestructibleRate + _settings.explosiveRate)
+                {
+                    brick.type = static_cast<std::uint8_t>(BrickType::Explosive);
+                    brick.color = 0xFF4000FF;
+                }
+                else if (kind < _settings.indestructibleRate + _settings.explosiveRate + _settings.multiHitRate)
+                {
+                    brick.type = static_cast<std::uint8_t>(BrickType::MultiHit);
+                    brick.hits = static_cast<std::uint8_t>(2 + random.below(std::max<std::uint32_t>(_settings.maxHits, 2) - 1));
+                    brick.color = 0xC0C0C0FF;
+                }
+
+                bricks.push_back(brick);
+            }
+        }
+    }
+
+    void LevelGenerator::generate(std::uint64_t seed, std::uint32_t count, BoardSet& set, Core::ThreadPool& pool) const
+    {
+        // note: boards have different sizes -> generated apart, then copied at their offset
+        std::vector<std::vector<LevelBrick>> boards(count);
+        pool.parallelFor(count, [this, seed, &boards](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+            {
+                boards[i].reserve(static_cast<std::size_t>(_settings.columns) * _settings.rows);
+                generate(seed, static_cast<std::uint32_t>(i), boards[i]);
+            }
+        }, BOARD_GRAIN);
+
+        set.boards.resize(count);
+        std::uint32_t total { 0 };
+        for (std::uint32_t i { 0 }; i < count; ++i)
+        {
+            set.boards[i] = LevelBoardEntry{ total, static_cast<std::uint32_t>(boards[i].size()) };
+            total += set.boards[i].brickCount;
+        }
+
+        set.bricks.resize(total);
+        pool.parallelFor(count, [&set, &boards](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+                if (!boards[i].empty())
+                    std::memcpy(&set.bricks[set.boards[i].firstBrick], boards[i].data(), boards[i].size() * sizeof(LevelBrick));
+        }, BOARD_GRAIN);
+    }
+
+    bool writeLevelPack(const std::string& binaryPath, const BoardSet& set)
+    {
+        return writeLevelPack(binaryPath, set.boards, set.bricks);
+    }
+}
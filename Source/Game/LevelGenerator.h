@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "Level.h"
+
+namespace Core
+{
+    class ThreadPool;
+}
+
+namespace Arkanoid
+{
+    enum class BoardPattern : std::uint8_t
+    {
+        Scatter,
+        Mirror,
+        Stripes,
+        Pyramid,
+        Checker,
+
+        NB_PATTERNS
+    };
+
+    struct GeneratorSettings
+    {
+        // lattice cells, bricks on screen for the defaults
+        std::uint32_t columns = countBlocksX;
+        std::uint32_t rows = 8;
+        // fill probability: density on top row, density * (1 - falloff) on bottom row
+        float density = .85f;
+        float falloff = .4f;
+        // special bricks, by cell filled (the rest is normal)
+        float multiHitRate = .12f;
+        float explosiveRate = .04f;
+        float indestructibleRate = .03f;
+        std::uint8_t maxHits = 4;
+    };
+
+    // Boards in level pack layout, boards[i] index bricks
+    struct BoardSet
+    {
+        std::vector<LevelBoardEntry> boards;
+        std::vector<LevelBrick> bricks;
+
+        std::uint32_t size() const noexcept { return static_cast<std::uint32_t>(boards.size()); }
+        LevelBoard board(std::uint32_t index) const noexcept
+        {
+            return { bricks.data() + boards[index].firstBrick, boards[index].brickCount };
+        }
+    };
+
+    // Seeded procedural boards on the brick lattice
+    // - board i of a set only depends on (seed, i): same set whatever the thread count
+    // - pattern and palette are drawn per board, brick types per cell
+    class LevelGenerator
+    {
+        GeneratorSettings _settings;
+
+    public:
+        explicit LevelGenerator(const GeneratorSettings& settings = {});
+
+        // append one board to bricks
+        void generate(std::uint64_t seed, std::uint32_t index, std::vector<LevelBrick>& bricks) const;
+
+        // count boards generated on the pool: each board in its own buffer, then packed in board order
+        void generate(std::uint64_t seed, std::uint32_t count, BoardSet& set, Core::ThreadPool& pool) const;
+
+        const GeneratorSettings& settings() const noexcept { return _settings; }
+    };
+
+    bool writeLevelPack(const std::string& binaryPath, const BoardSet& set);
+}
@@ -0,0 +1,31 @@
+#include "PaddleBrain.h"
+#include <cmath>
+
+namespace Arkanoid
+{
+    TrackingBrain::TrackingBrain(float width, float deadZone)
+        : _width{ width }, _deadZone{ deadZone }
+    {}
+
+    void TrackingBrain::decide(const PaddleObservation* observations, PaddleAction* actions, std::size_t count)
+    {
+        const float period{ 2.f * _width };
+
+        // note: no early exit, loop body is the same for every world -> vectorizable
+        for (std::size_t i { 0 }; i < count; ++i)
+        {
+            const PaddleObservation& o{ observations[i] };
+
+            // time to reach paddle line, 0 when ball goes up (follow it)
+            const float time{ o.ballVY > 0.f ? (o.paddleY - o.ballY) / o.ballVY : 0.f };
+
+            // unfold side walls: position on a 2 * width period, mirrored on second half
+            float x{ std::fmod(o.ballX + o.ballVX * time, period) };
+            x = x < 0.f ? x + period : x;
+            x = x > _width ? period - x : x;
+
+            const float delta{ x - o.paddleX };
+            actions[i] = static_cast<PaddleAction>((delta > _deadZone) - (delta < -_deadZone));
+        }
+    }
+}
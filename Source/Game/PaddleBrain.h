@@ -0,0 +1,41 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Arkanoid_Global.h"
+
+namespace Arkanoid
+{
+    // state seen by a paddle AI, one per world
+    // note: float whatever Real is -> same layout for every brain (and external trainers)
+    struct PaddleObservation
+    {
+        float ballX, ballY;
+        float ballVX, ballVY;
+        float paddleX, paddleY;
+        float paddleHalfWidth;
+    };
+
+    // -1 left, 0 stop, 1 right (same as MovePaddle command)
+    using PaddleAction = std::int8_t;
+
+    // Decide for every world in one call: no virtual call by entity
+    class PaddleBrain
+    {
+    public:
+        virtual ~PaddleBrain() = default;
+        virtual void decide(const PaddleObservation* observations, PaddleAction* actions, std::size_t count) = 0;
+    };
+
+    // Reference policy: follow the point where the ball will cross the paddle line
+    class TrackingBrain : public PaddleBrain
+    {
+        float _width;
+        // no move when target is this close to paddle center
+        float _deadZone;
+
+    public:
+        explicit TrackingBrain(float width = SCREEN_WIDTH, float deadZone = PADDLE_WIDTH / 4.f);
+
+        void decide(const PaddleObservation* observations, PaddleAction* actions, std::size_t count) override;
+    };
+}
@@ -0,0 +1,130 @@
+#include "Particles.h"
+
+#include <algorithm>
+#include <cmath>
+#include "ThreadPool.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace Arkanoid
+{
+    // px/ms^2
+    static constexpr float sGravity{ .0008f };
+
+    ParticleSystem::ParticleSystem(std::size_t capacity)
+        : _capacity{ capacity },
+        _x{ new float[capacity] }, _y{ new float[capacity] },
+        _vx{ new float[capacity] }, _vy{ new float[capacity] },
+        _life{ new float[capacity] }, _lifeStart{ new float[capacity] },
+        _color{ new Core::Color[capacity] }
+    {}
+
+    float ParticleSystem::random(float min, float max) noexcept
+    {
+        // xorshift32: cheap and good enough for effects
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 17;
+        _seed ^= _seed << 5;
+        return min + (max - min) * static_cast<float>(_seed >> 8) * (1.f / 16777216.f);
+    }
+
+    void ParticleSystem::emit(std::size_t count, float x, float y, Core::Color color, float speed, float life)
+    {
+        count = std::min(count, _capacity - _count);
+
+        for (std::size_t i { _count }; i < _count + count; ++i)
+        {
+            const float angle{ random(0.f, 6.2831853f) };
+            const float velocity{ random(.2f, 1.f) * speed };
+
+            _x[i] = x;
+            _y[i] = y;
+            _vx[i] = std::cos(angle) * velocity;
+            _vy[i] = std::sin(angle) * velocity;
+            _life[i] = _lifeStart[i] = random(.5f, 1.f) * life;
+            _color[i] = color;
+        }
+
+        _count += count;
+    }
+
+    void ParticleSystem::update(float ft)
+    {
+        integrate(ft);
+        compact();
+    }
+
+    void ParticleSystem::integrate(float ft) noexcept
+    {
+        float* x{ _x.get() };
+        float* y{ _y.get() };
+        float* vy{ _vy.get() };
+        const float* vx{ _vx.get() };
+        float* life{ _life.get() };
+
+        std::size_t i { 0 };
+
+#if defined(__AVX2__)
+        const __m256 vft{ _mm256_set1_ps(ft) };
+        const __m256 gravity{ _mm256_set1_ps(sGravity * ft) };
+
+        for (; i + 8 <= _count; i += 8)
+        {
+            const __m256 velY{ _mm256_add_ps(_mm256_loadu_ps(vy + i), gravity) };
+            _mm256_storeu_ps(vy + i, velY);
+            _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), vft)));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(velY, vft)));
+            _mm256_storeu_ps(life + i, _mm256_sub_ps(_mm256_loadu_ps(life + i), vft));
+        }
+#endif
+
+        // note: plain loop over separate arrays, auto vectorized without AVX2
+        for (; i < _count; ++i)
+        {
+            vy[i] += sGravity * ft;
+            x[i] += vx[i] * ft;
+            y[i] += vy[i] * ft;
+            life[i] -= ft;
+        }
+    }
+
+    void ParticleSystem::compact() noexcept
+    {
+        // dead particle is replaced by the last one (order does not matter)
+        for (std::size_t i { 0 }; i < _count;)
+        {
+            if (_life[i] > 0.f) { ++i; continue; }
+
+            const std::size_t last{ --_count };
+            _x[i] = _x[last]; _y[i] = _y[last];
+            _vx[i] = _vx[last]; _vy[i] = _vy[last];
+            _life[i] = _life[last]; _lifeStart[i] = _lifeStart[last];
+            _color[i] = _color[last];
+        }
+    }
+
+    void ParticleSystem::draw(Core::RenderBatch& batch, Core::ThreadPool* workers, float size) const
+    {
+        const std::size_t first{ batch.rectangles.size() };
+        batch.rectangles.resize(first + _count);
+        Core::RectangleInstance* out{ batch.rectangles.data() + first };
+
+        const float half{ size / 2.f };
+
+        auto fill = [this, out, half, size](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+            {
+                // fade out: alpha follow remaining life
+                const Core::Color alpha{ static_cast<Core::Color>(255.f * _life[i] / _lifeStart[i]) };
+                out[i] = Core::RectangleInstance{ _x[i] - half, _y[i] - half, size, size, (_color[i] & 0xFFFFFF00u) | alpha };
+            }
+        };
+
+        // note: each range write its own slice of the batch
+        if (workers) workers->parallelFor(_count, fill, 8192);
+        else fill(0, _count);
+    }
+}
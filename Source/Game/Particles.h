@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Library.h"
+#include "RenderBatch.h"
+
+namespace Core
+{
+    class ThreadPool;
+}
+
+namespace Arkanoid
+{
+    // Cosmetic particles (brick debris, sparks): not entities, no components
+    // - fixed capacity SoA pools allocated once, emit beyond capacity is dropped
+    // - one integration pass for all (AVX2 when available), dead ones are compacted
+    // - drawn as small rectangles appended to the render batch -> same single draw call
+    class ParticleSystem
+    {
+        std::size_t _capacity;
+        std::size_t _count = 0;
+
+        std::unique_ptr<float[]> _x, _y;
+        std::unique_ptr<float[]> _vx, _vy;
+        // remaining lifetime (ms), start value for fading
+        std::unique_ptr<float[]> _life, _lifeStart;
+        std::unique_ptr<Core::Color[]> _color;
+
+        std::uint32_t _seed = 0x9E3779B9u;
+
+        float random(float min, float max) noexcept;
+        void integrate(float ft) noexcept;
+        void compact() noexcept;
+
+    public:
+        explicit ParticleSystem(std::size_t capacity = 1u << 17);
+
+        // burst of count particles from (x, y), velocity in px/ms
+        void emit(std::size_t count, float x, float y, Core::Color color, float speed = .25f, float life = 600.f);
+
+        // ft in ms
+        void update(float ft);
+        // instances are filled on workers when given
+        void draw(Core::RenderBatch& batch, Core::ThreadPool* workers = nullptr, float size = 2.f) const;
+        void clear() noexcept { _count = 0; }
+
+        std::size_t size() const noexcept { return _count; }
+        std::size_t capacity() const noexcept { return _capacity; }
+    };
+}
@@ -0,0 +1,176 @@
+#include "PowerUpSystem.h"
+#include "Arkanoid_ECS.h"
+#include "Entity.h"
+#include "World.h"
+#include <algorithm>
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    PowerUpSystem::PowerUpSystem(World& world)
+        : _world{ world }
+    {}
+
+    void PowerUpSystem::Update(float ft)
+    {
+        Manager& manager = _world.manager();
+        _paddleBoxes.gather(manager.getEntitiesByGroup(World::GPaddle));
+        _powerUpBoxes.gather(manager.getEntitiesByGroup(World::GPowerUp));
+
+        for (std::size_t powerUp { 0 }; powerUp < _powerUpBoxes.size(); ++powerUp)
+        {
+            Entity& entity = *_powerUpBoxes.entities[powerUp];
+
+            for (std::size_t paddle { 0 }; paddle < _paddleBoxes.size(); ++paddle)
+            {
+                if (!intersects(_paddleBoxes, paddle, _powerUpBoxes, powerUp)) continue;
+
+                apply(entity.getComponent<CPowerUp>().Type(), *_paddleBoxes.entities[paddle]);
+                entity.destroy();
+                break;
+            }
+
+            if (entity.isAlive() && _powerUpBoxes.top[powerUp] > Real(SCREEN_HEIGHT))
+                entity.destroy();
+        }
+
+        updatePaddles(ft);
+        dropLasers();
+    }
+
+    void PowerUpSystem::apply(PowerUpType type, Entity& paddle)
+    {
+        PaddlePower& power = paddle.getComponent<CPaddlePower>().State();
+
+        switch (type)
+        {
+        case PowerUpType::Multiball:
+            multiball();
+            break;
+        case PowerUpType::WidePaddle:
+            // note: catching it again only extend the timer
+            if (power.wide <= 0.f) widen(paddle, WIDE_FACTOR);
+            power.wide = WIDE_DURATION;
+            break;
+        case PowerUpType::Laser:
+            if (power.laser <= 0.f) mountTurrets(paddle);
+            power.laser = LASER_DURATION;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void PowerUpSystem::multiball()
+    {
+        EntityList& balls = _world.manager().getEntitiesByGroup(World::GBall);
+
+        _positions.clear();
+        _velocities.clear();
+        for (Entity* ball : balls)
+        {
+            // note: a ball served on the paddle has no velocity yet -> its copies would never move
+            if (!ball->isAlive() || (ball->hasComponent<CParent>() && ball->getComponent<CParent>().Parent())) continue;
+            _positions.push_back(ball->getComponent<CPosition>().Get());
+            _velocities.push_back(ball->getComponent<CPhysics>().Velocity());
+        }
+
+        // each ball split in three: mirrored on x, mirrored on y
+        std::size_t count { _positions.size() };
+        for (std::size_t i { 0 }; i < _positions.size() && count < MAX_BALLS; ++i)
+        {
+            const CVect2& velocity { _velocities[i] };
+            _world.createBall(_positions[i], CVect2{ -velocity.x, velocity.y });
+            if (++count == MAX_BALLS) break;
+            _world.createBall(_positions[i], CVect2{ velocity.x, -velocity.y });
+            ++count;
+        }
+    }
+
+    void PowerUpSystem::widen(Entity& paddle, float factor)
+    {
+        // note: set from paddle definition sizes -> no drift after many wide/narrow cycles
+        CPhysics& body = paddle.getComponent<CPhysics>();
+        body.HalfSize(CVect2{ PADDLE_WIDTH / 2.f * factor, body.HalfSize().y });
+
+        // note: origin follow the size -> shape stays centered on the body
+        CRectangle& shape = paddle.getComponent<CRectangle>();
+        const CMath::Vect2 size { PADDLE_WIDTH * 1.5f * factor, shape.Size().y };
+        shape.Size(size).Origin({ size.x / 2.f, size.y / 2.f });
+
+        // turrets stay on the edges
+        for (Entity* turret : _world.manager().getEntitiesByGroup(World::GTurret))
+        {
+            CParent& link = turret->getComponent<CParent>();
+            if (!turret->isAlive() || link.Parent() != &paddle) continue;
+
+            const Real side { link.Local().x < Real{} ? -body.HalfSize().x : body.HalfSize().x };
+            link.Local(CVect2{ side, link.Local().y });
+        }
+    }
+
+    void PowerUpSystem::mountTurrets(Entity& paddle)
+    {
+        const CVect2& halfSize = paddle.getComponent<CPhysics>().HalfSize();
+        _world.createTurret(paddle, CVect2{ -halfSize.x, -halfSize.y });
+        _world.createTurret(paddle, CVect2{ halfSize.x, -halfSize.y });
+    }
+
+    void PowerUpSystem::dropTurrets(Entity& paddle)
+    {
+        for (Entity* turret : _world.manager().getEntitiesByGroup(World::GTurret))
+        {
+            if (turret->getComponent<CParent>().Parent() == &paddle)
+                turret->destroy();
+        }
+    }
+
+    void PowerUpSystem::updatePaddles(float ft)
+    {
+        for (Entity* paddle : _world.manager().getEntitiesByGroup(World::GPaddle))
+        {
+            if (!paddle->isAlive()) continue;
+            PaddlePower& power = paddle->getComponent<CPaddlePower>().State();
+
+            if (power.wide > 0.f)
+            {
+                power.wide -= ft;
+                if (power.wide <= 0.f)
+                {
+                    power.wide = 0.f;
+                    widen(*paddle, 1.f);
+                }
+            }
+
+            if (power.laser > 0.f)
+            {
+                power.laser = std::max(power.laser - ft, 0.f);
+                power.laserCooldown -= ft;
+
+                // one bolt from each paddle side, where the turrets sit
+                if (power.laserCooldown <= 0.f)
+                {
+                    const CPhysics& body = paddle->getComponent<CPhysics>();
+                    const Real y { body.top() - Real(LASER_HEIGHT / 2.f) };
+                    _world.createLaser(CVect2{ body.left(), y });
+                    _world.createLaser(CVect2{ body.right(), y });
+                    power.laserCooldown += LASER_COOLDOWN;
+                }
+
+                if (power.laser <= 0.f) dropTurrets(*paddle);
+            }
+            else
+                power.laserCooldown = 0.f;
+        }
+    }
+
+    void PowerUpSystem::dropLasers()
+    {
+        for (Entity* laser : _world.manager().getEntitiesByGroup(World::GLaser))
+        {
+            if (laser->isAlive() && laser->getComponent<CPhysics>().bottom() < Real{})
+                laser->destroy();
+        }
+    }
+}
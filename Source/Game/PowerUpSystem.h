@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "Collision.h"
+#include "System.h"
+
+namespace ECS
+{
+    class Entity;
+}
+
+namespace Arkanoid
+{
+    class World;
+    enum class PowerUpType : std::uint8_t;
+
+    // Power ups rules, run after collisions:
+    // - capsules caught by a paddle are applied, the ones below the screen are dropped
+    // - paddle timers (wide, laser) expire, active lasers fire from turrets riding on the paddle
+    // - lasers above the screen are dropped
+    class PowerUpSystem : public ECS::UpdateSystem
+    {
+        World& _world;
+
+        AabbSet _paddleBoxes;
+        AabbSet _powerUpBoxes;
+        // multiball: balls are copied before spawning (spawn grow the group)
+        std::vector<CVect2> _positions, _velocities;
+
+        void apply(PowerUpType type, ECS::Entity& paddle);
+        void multiball();
+        // paddle size = definition size * factor
+        void widen(ECS::Entity& paddle, float factor);
+        // laser turrets attached on the paddle edges
+        void mountTurrets(ECS::Entity& paddle);
+        void dropTurrets(ECS::Entity& paddle);
+        void updatePaddles(float ft);
+        void dropLasers();
+
+    public:
+        explicit PowerUpSystem(World& world);
+
+        void Update(float ft) override;
+    };
+}
@@ -0,0 +1,553 @@
+#include "World.h"
+#include "AIPaddleControl.h"
+#include "DamageSystem.h"
+#include "HierarchySystem.h"
+#include "Arkanoid_ECS.h"
+#include "Particles.h"
+#include "PowerUpSystem.h"
+#include "System.h"
+#include "Entity.h"
+#include "CMath.h"
+#include <algorithm>
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    // original hardcoded layout: countBlocksX x countBlocksY yellow bricks
+    static std::vector<LevelBrick> classicBoard()
+    {
+        std::vector<LevelBrick> bricks;
+        bricks.reserve(countBlocksX * countBlocksY);
+
+        for (int iX{ 0 }; iX < countBlocksX; ++iX)
+            for (int iY{ 0 }; iY < countBlocksY; ++iY)
+            {
+                LevelBrick brick{};
+                brick.x = (iX + 1) * BRICK_PITCH_X + BRICK_OFFSET_X;
+                brick.y = (iY + 1) * BRICK_PITCH_Y;
+                brick.color = Core::Colors::Yellow;
+                bricks.push_back(brick);
+            }
+
+        return bricks;
+    }
+
+    // brick definition and bulk loaded bricks must agree
+    static CVect2 brickHalfSize()
+    {
+        return { BLOCK_WIDTH / 2.f, BLOCK_HEIGHT / 2.f };
+    }
+
+    World::World(Core::RenderBatch* context)
+        : _context{ context }
+    {
+        _commands = &_manager.addSystem<CommandSystem>(_manager);
+        _hierarchy = &_manager.addSystem<HierarchySystem>(_manager);
+        _bounds = &_manager.addSystem<BoundsSystem>(_manager, GBall);
+        _damage = &_manager.addSystem<DamageSystem>(*this);
+        _powerUps = &_manager.addSystem<PowerUpSystem>(*this);
+
+        registerFactories();
+        buildPrefabs();
+
+        // brick field follows the brick entities, maintained at each refresh
+        _manager.onConstruct<CBrick>([this](const EntityList& bricks) { _bricks.insert(bricks); });
+        _manager.onDestroy<CBrick>([this](const EntityList& bricks) { _bricks.remove(bricks); });
+
+        createPaddle();
+        createBall();
+
+        // note: board is loaded in bulk and saved as level start
+        const std::vector<LevelBrick> bricks{ classicBoard() };
+        loadBoard(LevelBoard{ bricks.data(), static_cast<std::uint32_t>(bricks.size()) });
+    }
+
+    void World::loadBoard(const LevelBoard& board)
+    {
+        // nothing of the previous board is carried over: capsules, bolts and turrets go with the bricks
+        for (Group group : { GBrick, GPowerUp, GLaser, GTurret })
+        {
+            for (Entity* entity : _manager.getEntitiesByGroup(group))
+                entity->destroy();
+        }
+
+        // laser ends with its turrets
+        for (Entity* paddle : _manager.getEntitiesByGroup(GPaddle))
+        {
+            PaddlePower& power = paddle->getComponent<CPaddlePower>().State();
+            power.laser = power.laserCooldown = 0.f;
+        }
+        _manager.refresh();
+
+        // one bulk insert: storage reserved once, brick records written straight into new components (no factory, no Load)
+        // note: same signature and order as defineBrick -> snapshot layout of a loaded brick = prefab one
+        const CVect2 halfSize{ brickHalfSize() };
+        _manager.reserveGroup(GBrick, board.count);
+        _manager.createEntities<CPosition, CPhysics, CBrick>(board.count,
+            [&board, &halfSize](std::size_t i, Entity& entity, CPosition& position, CPhysics& body, CBrick& data)
+        {
+            const LevelBrick& brick{ board.bricks[i] };
+
+            position.Set(CVect2{ brick.x, brick.y });
+            body.HalfSize(halfSize);
+            // note: unknown types (newer pack) fall back to a normal brick
+            const BrickType type { brick.type < (std::uint8_t)BrickType::NB_TYPES ? static_cast<BrickType>(brick.type) : BrickType::Normal };
+            data.Type(type, brick.hits).Color(brick.color);
+
+            entity.addGroup(GBrick);
+        });
+        // sync point: new bricks are indexed by the construct hook
+        _manager.refresh();
+        _clearable = _bricks.remaining() > 0;
+
+        // keep level start to allow instant reset
+        save(_levelStart);
+    }
+
+    void World::executeCommands()
+    {
+        _commands->execute();
+    }
+
+    void World::step(Frametime ft, bool refresh)
+    {
+        beginStep(ft, refresh);
+        _bounds->Update(ft);
+        endStep(ft);
+    }
+
+    void World::beginStep(Frametime ft, bool refresh)
+    {
+        if (refresh) _manager.refresh();
+        // element must be update at fixed time to get precision
+        _manager.Update(ft);
+        // note: after parents moved, before collisions read children
+        _hierarchy->Update(ft);
+    }
+
+    void World::endStep(Frametime ft)
+    {
+        processCollisions();
+        _damage->Update(ft);
+        _powerUps->Update(ft);
+    }
+
+    std::uint32_t World::random() noexcept
+    {
+        _random ^= _random << 13;
+        _random ^= _random >> 17;
+        _random ^= _random << 5;
+        return _random;
+    }
+
+    void World::processCollisions()
+    {
+        // gather
+        _paddleBoxes.gather(_manager.getEntitiesByGroup(GPaddle));
+        _ballBoxes.gather(_manager.getEntitiesByGroup(GBall));
+        _laserBoxes.gather(_manager.getEntitiesByGroup(GLaser));
+
+        _ballVelocities.clear();
+        for (Entity* ball : _ballBoxes.entities)
+            _ballVelocities.push_back(ball->getComponent<CPhysics>().Velocity());
+
+        // same order as the brute force loop: by ball, paddles then bricks in board order
+        for (std::size_t ball { 0 }; ball < _ballBoxes.size(); ++ball)
+        {
+            for (std::size_t paddle { 0 }; paddle < _paddleBoxes.size(); ++paddle)
+                if (intersects(_paddleBoxes, paddle, _ballBoxes, ball)) processCollisionPB(paddle, ball);
+
+            _bricks.query(_ballBoxes.left[ball], _ballBoxes.top[ball], _ballBoxes.right[ball], _ballBoxes.bottom[ball], _candidates);
+            // note: a brick broken by a previous candidate is killed -> alive check
+            for (std::uint32_t brick : _candidates)
+                if (_bricks.alive(brick)) processCollisionBB(brick, ball);
+        }
+
+        // lasers stop on the first brick
+        for (std::size_t laser { 0 }; laser < _laserBoxes.size(); ++laser)
+        {
+            _bricks.query(_laserBoxes.left[laser], _laserBoxes.top[laser], _laserBoxes.right[laser], _laserBoxes.bottom[laser], _candidates);
+            if (!_candidates.empty()) processCollisionLB(_candidates.front(), laser);
+        }
+
+        // scatter, only responses (unchanged velocities keep their version)
+        for (std::size_t ball { 0 }; ball < _ballBoxes.size(); ++ball)
+        {
+            CPhysics& body = _ballBoxes.entities[ball]->getComponent<CPhysics>();
+            if (_ballVelocities[ball] != body.Velocity()) body.Velocity(CVect2{ _ballVelocities[ball] });
+        }
+    }
+
+    void World::draw()
+    {
+        if (!_context) return;
+
+        // note: gathered on the caller thread, one cached shape copied by entity (re-synced only when its position
+        // moved) and bricks reuse their list until one breaks -> even MAX_BALLS balls (~12 us) are below the
+        // VERTEX_GRAIN span the backend itself keeps on one thread, the vertex fill is where workers pay
+        _manager.Draw();
+        _bricks.draw(*_context);
+    }
+
+    void World::save(Snapshot& snapshot)
+    {
+        _manager.save(snapshot);
+
+        // note: drops are rolled from _random -> a replay from the snapshot drop the same power ups
+        snapshot.globals.clear();
+        snapshot.globals.write(_random);
+        snapshot.globals.write(_clearable);
+    }
+
+    void World::restore(Snapshot& snapshot)
+    {
+        _manager.restore(snapshot);
+        // note: records point to entities that may have been rebuilt
+        _commands->clear();
+        _damage->clear();
+        // note: state copied back in place is not a structural change (no hook) -> hits and alive are read again
+        _bricks.build(_manager.getEntitiesByGroup(GBrick));
+
+        snapshot.globals.rewind();
+        snapshot.globals.read(_random);
+        snapshot.globals.read(_clearable);
+    }
+
+    void World::movePaddles(std::int8_t direction)
+    {
+        // note: only changes are emitted -> one record per transition, not per frame
+        for (Entity* paddle : _manager.getEntitiesByGroup(GPaddle))
+        {
+            if (paddle->getComponent<CPaddleControl>().Direction() != direction)
+                _commands->push(*paddle, CommandType::MovePaddle, direction);
+        }
+    }
+
+    void World::observe(AIPaddleControl& ai)
+    {
+        EntityList& balls = _manager.getEntitiesByGroup(GBall);
+        if (balls.empty()) return;
+
+        // follow the lowest ball
+        Entity* ball = *std::max_element(balls.begin(), balls.end(), [](const Entity* a, const Entity* b)
+        {
+            return a->getComponent<CPosition>().Get().y < b->getComponent<CPosition>().Get().y;
+        });
+
+        for (Entity* paddle : _manager.getEntitiesByGroup(GPaddle))
+            ai.observe(*_commands, *paddle, *ball);
+    }
+
+    Entity& World::createBall()
+    {
+        return _manager.instantiate(_ballPrefab);
+    }
+
+    Entity& World::createBall(const CVect2& position, const CVect2& velocity)
+    {
+        auto& entity = _manager.instantiate(_ballPrefab);
+
+        entity.getComponent<CPosition>().Set(position);
+        entity.getComponent<CPhysics>().Velocity(CVect2{ velocity });
+
+        return entity;
+    }
+
+    Entity& World::createBrick(const CVect2& position, Core::Color color)
+    {
+        auto& entity = _manager.instantiate(_brickPrefab);
+
+        entity.getComponent<CPosition>().Set(position);
+        entity.getComponent<CBrick>().Color(color);
+        _clearable = true;
+
+        return entity;
+    }
+
+    Entity& World::createPaddle()
+    {
+        return _manager.instantiate(_paddlePrefab);
+    }
+
+    Entity& World::createPowerUp(const CVect2& position, PowerUpType type)
+    {
+        static constexpr Core::Color colors[] { Core::Colors::Cyan, Core::Colors::Green, Core::Colors::Red };
+        static_assert(sizeof(colors) / sizeof(colors[0]) == (size_t)PowerUpType::NB_TYPES, "one colour by power up");
+
+        auto& entity = _manager.instantiate(_powerUpPrefab);
+
+        entity.getComponent<CPosition>().Set(position);
+        entity.getComponent<CPowerUp>().Type(type);
+        entity.getComponent<CRectangle>().Color(colors[(size_t)type]);
+
+        return entity;
+    }
+
+    Entity& World::createLaser(const CVect2& position)
+    {
+        auto& entity = _manager.instantiate(_laserPrefab);
+
+        entity.getComponent<CPosition>().Set(position);
+
+        return entity;
+    }
+
+    Entity& World::createTurret(Entity& paddle, const CVect2& local)
+    {
+        auto& entity = _manager.instantiate(_turretPrefab);
+
+        // note: placed now, hierarchy only moves it from the next step
+        entity.getComponent<CPosition>().Set(paddle.getComponent<CPosition>().Get() + local);
+        attach(entity, paddle, local);
+
+        return entity;
+    }
+
+    void World::attach(Entity& child, Entity& parent, const CVect2& local)
+    {
+        if (!child.hasComponent<CParent>())
+            child.addComponent<CParent>(child);
+
+        child.getComponent<CParent>().Parent(&parent).Local(local);
+    }
+
+    void World::detach(Entity& child)
+    {
+        if (child.hasComponent<CParent>())
+            child.getComponent<CParent>().Parent(nullptr);
+    }
+
+    void World::serve()
+    {
+        EntityList& balls = _manager.getEntitiesByGroup(GBall);
+        EntityList& paddles = _manager.getEntitiesByGroup(GPaddle);
+        if (balls.empty() || paddles.empty()) return;
+
+        Entity& ball = *balls.front();
+        Entity& paddle = *paddles.front();
+
+        // resting on the paddle: ball box stay clear of the paddle box (no bounce)
+        const CVect2 local { Real{}, -(paddle.getComponent<CPhysics>().HalfSize().y + Real(BALL_RADIUS + 1.f)) };
+        ball.getComponent<CPhysics>().Velocity(CVect2{});
+        ball.getComponent<CPosition>().Set(paddle.getComponent<CPosition>().Get() + local);
+        attach(ball, paddle, local);
+    }
+
+    void World::launch()
+    {
+        for (Entity* ball : _manager.getEntitiesByGroup(GBall))
+        {
+            if (!ball->isAlive() || !ball->hasComponent<CParent>()) continue;
+
+            const Entity* parent { ball->getComponent<CParent>().Parent() };
+            if (!parent || !parent->hasGroup(GPaddle)) continue;
+
+            detach(*ball);
+            ball->getComponent<CPhysics>().Velocity(CVect2{ -BALL_VELOCITY, -BALL_VELOCITY });
+        }
+    }
+
+    void World::buildPrefabs()
+    {
+        // entity definitions are captured once then only copied
+        Entity* definitions[] { &defineBall(), &defineBrick(), &definePaddle(), &definePowerUp(), &defineLaser(), &defineTurret() };
+        _manager.makePrefab(*definitions[0], _ballPrefab);
+        _manager.makePrefab(*definitions[1], _brickPrefab);
+        _manager.makePrefab(*definitions[2], _paddlePrefab);
+        _manager.makePrefab(*definitions[3], _powerUpPrefab);
+        _manager.makePrefab(*definitions[4], _laserPrefab);
+        _manager.makePrefab(*definitions[5], _turretPrefab);
+
+        for (Entity* entity : definitions)
+            entity->destroy();
+        _manager.refresh();
+    }
+
+    Entity& World::defineBall()
+    {
+        auto& entity = _manager.addEntity();
+
+        entity.addComponent<CPosition>(entity, CVect2{ SCREEN_WIDTH / 2.f, SCREEN_HEIGHT / 2.f });
+        entity.addComponent<CCircle>(entity, _context, BALL_RADIUS).Color(Core::Colors::White);
+        entity.addComponent<CPhysics>(entity, CVect2{ BALL_RADIUS, BALL_RADIUS })
+            .Velocity(CVect2{ -BALL_VELOCITY, -BALL_VELOCITY })
+            // screen walls are processed in batch by BoundsSystem
+            .Bounce(true);
+
+        entity.addGroup(ArkanoidGroup::GBall);
+
+        return entity;
+    }
+
+    Entity& World::defineBrick()
+    {
+        auto& entity = _manager.addEntity();
+
+        entity.addComponent<CPosition>(entity);
+        entity.addComponent<CPhysics>(entity, brickHalfSize());
+        entity.addComponent<CBrick>(entity);
+
+        entity.addGroup(ArkanoidGroup::GBrick);
+
+        return entity;
+    }
+
+    Entity& World::definePaddle()
+    {
+        CVect2 _halfSize{ PADDLE_WIDTH / 2.f, PADDLE_HEIGHT / 2.f };
+        auto& entity(_manager.addEntity());
+
+        entity.addComponent<CPosition>(entity, CVect2{ SCREEN_WIDTH / 2.f, SCREEN_HEIGHT - 60.f });
+        entity.addComponent<CPhysics>(entity, _halfSize);
+        entity.addComponent<CRectangle>(entity, _context)
+            .Size({ PADDLE_WIDTH * 1.5f, PADDLE_HEIGHT * 0.5f })
+            .Origin({ PADDLE_WIDTH * 1.5f / 2.f, PADDLE_HEIGHT * 0.5f / 2.f });
+        entity.addComponent<CPaddleControl>(entity);
+        entity.addComponent<CPaddlePower>(entity);
+
+        entity.addGroup(ArkanoidGroup::GPaddle);
+
+        return entity;
+    }
+
+    Entity& World::definePowerUp()
+    {
+        CVect2 _halfSize{ POWERUP_WIDTH / 2.f, POWERUP_HEIGHT / 2.f };
+        auto& entity = _manager.addEntity();
+
+        entity.addComponent<CPosition>(entity);
+        entity.addComponent<CPhysics>(entity, _halfSize).Velocity(CVect2{ 0.f, POWERUP_VELOCITY });
+        entity.addComponent<CRectangle>(entity, _context)
+            .Size({ POWERUP_WIDTH, POWERUP_HEIGHT })
+            .Origin({ POWERUP_WIDTH / 2.f, POWERUP_HEIGHT / 2.f });
+        entity.addComponent<CPowerUp>(entity);
+
+        entity.addGroup(ArkanoidGroup::GPowerUp);
+
+        return entity;
+    }
+
+    Entity& World::defineLaser()
+    {
+        CVect2 _halfSize{ LASER_WIDTH / 2.f, LASER_HEIGHT / 2.f };
+        auto& entity = _manager.addEntity();
+
+        entity.addComponent<CPosition>(entity);
+        entity.addComponent<CPhysics>(entity, _halfSize).Velocity(CVect2{ 0.f, -LASER_VELOCITY });
+        entity.addComponent<CRectangle>(entity, _context)
+            .Size({ LASER_WIDTH, LASER_HEIGHT })
+            .Origin({ LASER_WIDTH / 2.f, LASER_HEIGHT / 2.f })
+            .Color(Core::Colors::Magenta);
+
+        entity.addGroup(ArkanoidGroup::GLaser);
+
+        return entity;
+    }
+
+    Entity& World::defineTurret()
+    {
+        auto& entity = _manager.addEntity();
+
+        entity.addComponent<CPosition>(entity);
+        entity.addComponent<CRectangle>(entity, _context)
+            .Size({ TURRET_WIDTH, TURRET_HEIGHT })
+            .Origin({ TURRET_WIDTH / 2.f, TURRET_HEIGHT / 2.f })
+            .Color(Core::Colors::Magenta);
+        entity.addComponent<CParent>(entity);
+
+        entity.addGroup(ArkanoidGroup::GTurret);
+
+        return entity;
+    }
+
+    void World::registerFactories()
+    {
+        // default construction only, state is then loaded from snapshot
+        _manager.registerFactory<CPosition>([](Entity& e) -> CPosition& { return e.addComponent<CPosition>(e); });
+        _manager.registerFactory<CPhysics>([](Entity& e) -> CPhysics& { return e.addComponent<CPhysics>(e); });
+        _manager.registerFactory<CCircle>([this](Entity& e) -> CCircle& { return e.addComponent<CCircle>(e, _context); });
+        _manager.registerFactory<CRectangle>([this](Entity& e) -> CRectangle& { return e.addComponent<CRectangle>(e, _context); });
+        _manager.registerFactory<CPaddleControl>([](Entity& e) -> CPaddleControl& { return e.addComponent<CPaddleControl>(e); });
+        _manager.registerFactory<CPaddlePower>([](Entity& e) -> CPaddlePower& { return e.addComponent<CPaddlePower>(e); });
+        _manager.registerFactory<CBrick>([](Entity& e) -> CBrick& { return e.addComponent<CBrick>(e); });
+        _manager.registerFactory<CParent>([](Entity& e) -> CParent& { return e.addComponent<CParent>(e); });
+        _manager.registerFactory<CPowerUp>([](Entity& e) -> CPowerUp& { return e.addComponent<CPowerUp>(e); });
+    }
+
+    System& World::createSystem()
+    {
+        auto& entity = _manager.addSystem<ECS::UpdateSystem>();
+
+        return entity;
+    }
+
+    void World::processCollisionPB(std::size_t paddle, std::size_t ball)
+    {
+        const Real speed{ BALL_VELOCITY };
+
+        if (_ballBoxes.centerX[ball] < _paddleBoxes.centerX[paddle])
+            _ballVelocities[ball] = { -speed, -speed };
+        else 
+            _ballVelocities[ball] = { speed, -speed };
+    }
+
+    void World::breakBrick(Entity& brick)
+    {
+        brick.destroy();
+
+        std::uint32_t slot;
+        if (_bricks.find(brick, slot)) _bricks.kill(slot);
+
+        const CVect2& position = brick.getComponent<CPosition>().Get();
+
+        if (_effects)
+            _effects->emit(48, static_cast<float>(position.x), static_cast<float>(position.y), brick.getComponent<CBrick>().Color());
+
+        if (random() % POWERUP_DROP_RATE == 0)
+            createPowerUp(position, static_cast<PowerUpType>(random() % (std::uint32_t)PowerUpType::NB_TYPES));
+    }
+
+    void World::damageBrick(std::uint32_t brick)
+    {
+        BrickState& state = _bricks.state(brick);
+        if (state.type == BrickType::Indestructible) return;
+
+        _damage->push(_bricks.entity(brick));
+        if (--state.hits == 0) _bricks.kill(brick);
+    }
+
+    void World::processCollisionLB(std::uint32_t brick, std::size_t laser)
+    {
+        _laserBoxes.alive[laser] = 0;
+        _laserBoxes.entities[laser]->destroy();
+
+        damageBrick(brick);
+    }
+
+    void World::processCollisionBB(std::uint32_t brick, std::size_t ball)
+    {
+        damageBrick(brick);
+
+        // test collision scenario to deduce reaction
+        Real overlapLeft = _ballBoxes.right[ball] - _bricks.left(brick);
+        Real overlapRight = _bricks.right(brick) - _ballBoxes.left[ball];
+        Real overlapTop = _ballBoxes.bottom[ball] - _bricks.top(brick);
+        Real overlapBottom = _bricks.bottom(brick) - _ballBoxes.top[ball];
+
+        bool BallFromLeft = CMath::abs(overlapLeft) < CMath::abs(overlapRight);
+        bool BallFromTop = CMath::abs(overlapTop) < CMath::abs(overlapBottom);
+
+        Real minOverlapX = BallFromLeft ? overlapLeft : overlapRight;
+        Real minOverlapY = BallFromTop ? overlapTop : overlapBottom;
+
+        const Real speed{ BALL_VELOCITY };
+        CVect2& velocity{ _ballVelocities[ball] };
+
+        // deduce if ball repel horizontally or vertically
+        if (CMath::abs(minOverlapX) < CMath::abs(minOverlapY))
+            velocity.x = BallFromLeft ? -speed : speed;
+        else
+            velocity.y = BallFromTop ? -speed : speed;
+    }
+}
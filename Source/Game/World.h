@@ -0,0 +1,163 @@
+#pragma once
+#include <cstdint>
+#include "Arkanoid_Global.h"
+#include "Arkanoid_Command.h"
+#include "Arkanoid_ECS.h"
+#include "BoundsSystem.h"
+#include "BrickField.h"
+#include "Collision.h"
+#include "Manager.h"
+#include "Level.h"
+#include "RenderBatch.h"
+
+using namespace ECS;
+namespace ECS {
+    class Entity;
+    class System;
+}
+
+namespace Arkanoid
+{
+    class AIPaddleControl;
+    class ParticleSystem;
+    class DamageSystem;
+    class HierarchySystem;
+    class PowerUpSystem;
+
+    // One simulation: entities, board and rules, no window nor input device
+    // note: Game drive one world with a window, WorldRunner drive many headless
+    class World
+    {
+    public:
+        // we define group to accelerate testing
+        enum ArkanoidGroup : uint
+        {
+            GPaddle,
+            GBrick,
+            GBall,
+            GPowerUp,
+            GLaser,
+            GTurret
+        };
+
+    private:
+        // nullptr -> headless, Draw must not be called
+        Core::RenderBatch* _context;
+        // brick break effects (optional, render side)
+        ParticleSystem* _effects = nullptr;
+        Manager _manager;
+        // player, AI (and later network) inputs go through commands
+        CommandSystem* _commands = nullptr;
+        // attached entities follow their parent
+        HierarchySystem* _hierarchy = nullptr;
+        // screen walls of balls
+        BoundsSystem* _bounds = nullptr;
+        // brick hits, resolved after collisions
+        DamageSystem* _damage = nullptr;
+        // catch, timers and lasers of power ups
+        PowerUpSystem* _powerUps = nullptr;
+        // drop rolls (xorshift, one sequence by world)
+        std::uint32_t _random = 0x9E3779B9u;
+        // board has breakable bricks: only such a board can be cleared
+        bool _clearable = false;
+
+        // level start (reset)
+        Snapshot _levelStart;
+
+        // entity definitions, instantiated by copy
+        Prefab _ballPrefab;
+        Prefab _brickPrefab;
+        Prefab _paddlePrefab;
+        Prefab _powerUpPrefab;
+        Prefab _laserPrefab;
+        Prefab _turretPrefab;
+
+        // collision stage: groups packed once per step, responses written back at the end
+        AabbSet _paddleBoxes;
+        AabbSet _ballBoxes;
+        AabbSet _laserBoxes;
+        std::vector<CVect2> _ballVelocities;
+        // bricks don't move: indexed once by cell at load, balls only look at the cells they cover
+        BrickField _bricks;
+        std::vector<std::uint32_t> _candidates;
+
+        std::uint32_t random() noexcept;
+
+        void processCollisions();
+        void processCollisionPB(std::size_t paddle, std::size_t ball);
+        void processCollisionBB(std::uint32_t brick, std::size_t ball);
+        void processCollisionLB(std::uint32_t brick, std::size_t laser);
+        // emit a damage event, brick is ignored by the rest of the pass if it will break
+        void damageBrick(std::uint32_t brick);
+
+        void registerFactories();
+        void buildPrefabs();
+        Entity& defineBall();
+        Entity& defineBrick();
+        Entity& definePaddle();
+        Entity& definePowerUp();
+        Entity& defineLaser();
+        Entity& defineTurret();
+
+    public:
+        // start with paddle, ball and the classic board
+        explicit World(Core::RenderBatch* context = nullptr);
+
+        // factories lambdas keep this
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+        // factory
+        Entity& createBall();
+        Entity& createBall(const CVect2& position, const CVect2& velocity);
+        Entity& createBrick(const CVect2& position, Core::Color color = Core::Colors::Yellow);
+        Entity& createPaddle();
+        Entity& createPowerUp(const CVect2& position, PowerUpType type);
+        Entity& createLaser(const CVect2& position);
+        Entity& createTurret(Entity& paddle, const CVect2& local);
+        System& createSystem();
+
+        // replace current bricks, board is saved as level start
+        void loadBoard(const LevelBoard& board);
+
+        // apply commands emitted since last call
+        void executeCommands();
+        // one fixed step: refresh (optional), update, collisions
+        // note: without refresh, destroyed entities stay in groups until next refresh (skipped by collisions)
+        void step(Frametime ft, bool refresh = true);
+        // step without the bounds pass of balls, done in between by the caller (see BallLanes)
+        void beginStep(Frametime ft, bool refresh = true);
+        void endStep(Frametime ft);
+        void refresh() { _manager.refresh(); }
+        void draw();
+
+        void save(Snapshot& snapshot);
+        void restore(Snapshot& snapshot);
+        void resetLevel() { restore(_levelStart); }
+        // no breakable brick left (a board without any, empty or indestructible only, is never complete)
+        bool levelComplete() const noexcept { return _clearable && _bricks.remaining() == 0; }
+
+        // destroy, effects and power up drop
+        void breakBrick(Entity& brick);
+
+        // child position = parent position + local from the next step, see HierarchySystem
+        void attach(Entity& child, Entity& parent, const CVect2& local);
+        void detach(Entity& child);
+        // sticky ball: first ball waits on the first paddle until launch
+        void serve();
+        // release balls attached to a paddle, upward
+        void launch();
+
+        // emit MovePaddle for paddles not already going this way
+        void movePaddles(std::int8_t direction);
+        // paddles follow the lowest ball
+        void observe(AIPaddleControl& ai);
+
+        void effects(ParticleSystem* effects) noexcept { _effects = effects; }
+
+        Manager& manager() noexcept { return _manager; }
+        BrickField& bricks() noexcept { return _bricks; }
+        CommandSystem& commands() noexcept { return *_commands; }
+        const BoundsSystem& bounds() const noexcept { return *_bounds; }
+    };
+}
@@ -0,0 +1,127 @@
+#include "WorldLanes.h"
+#include "Arkanoid_ECS.h"
+#include "BoundsSystem.h"
+#include "Entity.h"
+#include "World.h"
+#include <cassert>
+
+using namespace ECS;
+
+namespace Arkanoid
+{
+    void BallLanes::bind(World& world)
+    {
+        assert(_lanes.size() < BALL_LANES && "lane set is full");
+
+        _lanes.emplace_back();
+        _lanes.back().world = &world;
+        gather(_lanes.size() - 1);
+    }
+
+    void BallLanes::gather(std::size_t index)
+    {
+        Lane& lane { _lanes[index] };
+        const BoundsSystem& bounds { lane.world->bounds() };
+
+        lane.layout = bounds.layout();
+        lane.bodies.clear();
+        lane.positions.clear();
+
+        for (Entity* ball : lane.world->manager().getEntitiesByGroup(bounds.group()))
+        {
+            CPhysics& body = ball->getComponent<CPhysics>();
+            if (!body.Bounce()) continue;
+
+            lane.bodies.push_back(&body);
+            lane.positions.push_back(&ball->getComponent<CPosition>());
+        }
+        lane.bodyVersions.resize(lane.bodies.size());
+        lane.positionVersions.resize(lane.bodies.size());
+
+        // note: slot major -> more slots only append zero lanes at the end
+        if (lane.bodies.size() > _slots)
+        {
+            _slots = lane.bodies.size();
+            for (std::vector<Real>* array : { &_x, &_y, &_vx, &_vy, &_hx, &_hy })
+                array->resize(_slots * BALL_LANES);
+        }
+
+        for (std::size_t ball { 0 }; ball < lane.bodies.size(); ++ball)
+            load(index, ball);
+
+        // balls this world no longer has
+        for (std::size_t ball { lane.bodies.size() }; ball < _slots; ++ball)
+        {
+            const std::size_t i { ball * BALL_LANES + index };
+            _x[i] = _y[i] = _vx[i] = _vy[i] = _hx[i] = _hy[i] = Real{};
+        }
+    }
+
+    bool BallLanes::sync(std::size_t index)
+    {
+        Lane& lane { _lanes[index] };
+        if (lane.world->bounds().layout() != lane.layout) return false;
+
+        for (std::size_t ball { 0 }; ball < lane.bodies.size(); ++ball)
+        {
+            if (lane.bodies[ball]->version() == lane.bodyVersions[ball] && lane.positions[ball]->version() == lane.positionVersions[ball])
+                continue;
+
+            // no longer bouncing -> not a lane body
+            if (!lane.bodies[ball]->Bounce()) return false;
+            load(index, ball);
+        }
+
+        return true;
+    }
+
+    void BallLanes::load(std::size_t index, std::size_t ball)
+    {
+        Lane& lane { _lanes[index] };
+        const CPhysics& body { *lane.bodies[ball] };
+        const CPosition& position { *lane.positions[ball] };
+        const std::size_t i { ball * BALL_LANES + index };
+
+        _x[i] = position.Get().x;
+        _y[i] = position.Get().y;
+        _vx[i] = body.Velocity().x;
+        _vy[i] = body.Velocity().y;
+        _hx[i] = body.HalfSize().x;
+        _hy[i] = body.HalfSize().y;
+
+        lane.bodyVersions[ball] = body.version();
+        lane.positionVersions[ball] = position.version();
+    }
+
+    void BallLanes::writeBack(std::size_t index)
+    {
+        Lane& lane { _lanes[index] };
+
+        for (std::size_t ball { 0 }; ball < lane.bodies.size(); ++ball)
+        {
+            const std::size_t i { ball * BALL_LANES + index };
+            CPhysics& body { *lane.bodies[ball] };
+            CPosition& position { *lane.positions[ball] };
+
+            // note: collisions read components -> positions are written every step
+            position.Set(CVect2{ _x[i], _y[i] });
+            const CVect2 velocity { _vx[i], _vy[i] };
+            if (velocity != body.Velocity()) body.Velocity(CVect2{ velocity });
+
+            lane.bodyVersions[ball] = body.version();
+            lane.positionVersions[ball] = position.version();
+        }
+    }
+
+    void BallLanes::integrate(Frametime ft)
+    {
+        for (std::size_t lane { 0 }; lane < _lanes.size(); ++lane)
+            if (!sync(lane)) gather(lane);
+
+        integrateBounce(_slots * BALL_LANES, _x.data(), _y.data(), _vx.data(), _vy.data(), _hx.data(), _hy.data(),
+            Real(ft), Real(SCREEN_WIDTH), Real(SCREEN_HEIGHT));
+
+        for (std::size_t lane { 0 }; lane < _lanes.size(); ++lane)
+            writeBack(lane);
+    }
+}
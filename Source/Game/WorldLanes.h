@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Arkanoid_Global.h"
+#include "Component.h"
+
+namespace Arkanoid
+{
+    class CPosition;
+    class World;
+
+    // worlds integrated by one lane set, one float by world in an AVX2 register
+    constexpr std::size_t BALL_LANES { 8 };
+
+    // Bouncing balls of up to BALL_LANES worlds side by side (SoA), world index is the SIMD lane
+    // - ball k of world w is stored at k * BALL_LANES + w: one AVX2 pass integrates the k-th ball of 8 worlds
+    // - lanes are resident: a ball is read again only when its CPosition or CPhysics version moved since the
+    //   lanes wrote it back (collision response, hierarchy, restore), a world only when its bodies changed
+    // - lanes of a missing ball or world are zero: they never move nor bounce
+    // note: worlds are stepped with World::beginStep/endStep, lanes replace their BoundsSystem pass in between
+    class BallLanes
+    {
+        struct Lane
+        {
+            World* world = nullptr;
+            // BoundsSystem::layout seen by the last gather
+            std::uint32_t layout = 0;
+            std::vector<CPhysics*> bodies;
+            std::vector<CPosition*> positions;
+            // versions left by the last write back (or read)
+            std::vector<ECS::Version> bodyVersions, positionVersions;
+        };
+
+        std::vector<Lane> _lanes;
+        // balls by world the arrays can hold (max of the lanes, never shrink)
+        std::size_t _slots = 0;
+        std::vector<Real> _x, _y;
+        std::vector<Real> _vx, _vy;
+        std::vector<Real> _hx, _hy;
+
+        // rebuild a lane from the ball group of its world
+        void gather(std::size_t lane);
+        // read changed balls, false if the lane must be gathered again
+        bool sync(std::size_t lane);
+        void load(std::size_t lane, std::size_t ball);
+        void writeBack(std::size_t lane);
+
+    public:
+        // next lane integrates the balls of world (at most BALL_LANES worlds)
+        void bind(World& world);
+
+        // position += velocity * ft then reflect on screen bounds, for the balls of every bound world
+        void integrate(Frametime ft);
+
+        std::size_t size() const noexcept { return _lanes.size(); }
+        std::size_t slots() const noexcept { return _slots; }
+    };
+}
@@ -0,0 +1,122 @@
+#include "WorldRunner.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Arkanoid
+{
+    WorldRunner::WorldRunner(std::size_t worlds, std::size_t threads, std::unique_ptr<PaddleBrain> brain)
+        : _pool{ threads }, _ai{ std::move(brain) }
+    {
+        _worlds.resize(worlds);
+        _ai.reserve(worlds);
+
+        // note: worlds are built by the thread that will mostly touch them (memory locality)
+        _pool.parallelFor(worlds, [this](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+                _worlds[i] = std::make_unique<World>();
+        });
+    }
+
+    void WorldRunner::loadBoard(const LevelBoard& board)
+    {
+        _pool.parallelFor(_worlds.size(), [this, &board](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+                _worlds[i]->loadBoard(board);
+        });
+    }
+
+    void WorldRunner::loadBoards(const LevelPack& pack)
+    {
+        if (pack.boardCount() == 0) return;
+
+        _pool.parallelFor(_worlds.size(), [this, &pack](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+                _worlds[i]->loadBoard(pack.board(static_cast<std::uint32_t>(i % pack.boardCount())));
+        });
+    }
+
+    void WorldRunner::vectorized(bool enable)
+    {
+        _lanes.clear();
+        if (!enable) return;
+
+        _lanes.resize((_worlds.size() + BALL_LANES - 1) / BALL_LANES);
+        for (std::size_t i { 0 }; i < _worlds.size(); ++i)
+            _lanes[i / BALL_LANES].bind(*_worlds[i]);
+    }
+
+    void WorldRunner::stepWorlds(std::size_t begin, std::size_t end, std::size_t steps)
+    {
+        for (std::size_t i { begin }; i < end; ++i)
+        {
+            World& world{ *_worlds[i] };
+            world.executeCommands();
+
+            for (std::size_t step { 0 }; step < steps; ++step)
+                world.step(FT_STEP);
+        }
+    }
+
+    void WorldRunner::stepLaneGroup(std::size_t group, std::size_t steps)
+    {
+        const std::size_t begin { group * BALL_LANES };
+        const std::size_t end { std::min(begin + BALL_LANES, _worlds.size()) };
+        BallLanes& lanes { _lanes[group] };
+
+        for (std::size_t i { begin }; i < end; ++i)
+            _worlds[i]->executeCommands();
+
+        for (std::size_t step { 0 }; step < steps; ++step)
+        {
+            for (std::size_t i { begin }; i < end; ++i)
+                _worlds[i]->beginStep(FT_STEP);
+
+            lanes.integrate(FT_STEP);
+
+            for (std::size_t i { begin }; i < end; ++i)
+                _worlds[i]->endStep(FT_STEP);
+        }
+    }
+
+    RunnerStats WorldRunner::run(std::size_t frames, std::size_t stepsPerFrame)
+    {
+        const auto start(std::chrono::steady_clock::now());
+
+        for (std::size_t frame { 0 }; frame < frames; ++frame)
+        {
+            // one brain call for all worlds
+            for (auto &world : _worlds)
+                world->observe(_ai);
+            _ai.decide();
+
+            if (vectorized())
+            {
+                _pool.parallelFor(_lanes.size(), [this, stepsPerFrame](std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t group { begin }; group < end; ++group)
+                        stepLaneGroup(group, stepsPerFrame);
+                });
+            }
+            else
+            {
+                _pool.parallelFor(_worlds.size(), [this, stepsPerFrame](std::size_t begin, std::size_t end)
+                {
+                    stepWorlds(begin, end, stepsPerFrame);
+                });
+            }
+        }
+
+        const std::chrono::duration<double> elapsed(std::chrono::steady_clock::now() - start);
+
+        const std::size_t completed = std::count_if(_worlds.begin(), _worlds.end(), [](const std::unique_ptr<World>& world)
+        {
+            return world->levelComplete();
+        });
+
+        return RunnerStats{ _worlds.size(), _pool.concurrency(), frames * stepsPerFrame * _worlds.size(), elapsed.count(), completed };
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "AIPaddleControl.h"
+#include "Level.h"
+#include "ThreadPool.h"
+#include "World.h"
+#include "WorldLanes.h"
+
+namespace Arkanoid
+{
+    struct RunnerStats
+    {
+        std::size_t worlds;
+        std::size_t threads;
+        // fixed steps, all worlds together
+        std::size_t steps;
+        double seconds;
+        // worlds with their board cleared at the end of the run
+        std::size_t completed;
+
+        double stepsPerSecond() const noexcept { return seconds > 0. ? steps / seconds : 0.; }
+    };
+
+    // Host many independent headless worlds and step them in parallel (evaluation sweeps)
+    // - paddles of every world are driven by one batched AI decision per frame
+    // - between decisions each world is stepped by a single thread, no shared state
+    class WorldRunner
+    {
+        // note: stable address, worlds are referenced by their own factories
+        std::vector<std::unique_ptr<World>> _worlds;
+        Core::ThreadPool _pool;
+        AIPaddleControl _ai;
+
+        // vectorized mode: worlds are stepped by groups of BALL_LANES, balls of a group share one lane set
+        std::vector<BallLanes> _lanes;
+
+        void stepWorlds(std::size_t begin, std::size_t end, std::size_t steps);
+        void stepLaneGroup(std::size_t group, std::size_t steps);
+
+    public:
+        // threads = 0 -> hardware concurrency
+        explicit WorldRunner(std::size_t worlds, std::size_t threads = 0, std::unique_ptr<PaddleBrain> brain = nullptr);
+
+        // same board for every world
+        void loadBoard(const LevelBoard& board);
+        // board (index % boardCount) for each world
+        void loadBoards(const LevelPack& pack);
+
+        // balls integrated in SoA across worlds (AVX2 when available) instead of by world
+        // note: same results as stepping each world, lane state stays resident between steps
+        void vectorized(bool enable);
+        bool vectorized() const noexcept { return !_lanes.empty(); }
+
+        // frames of stepsPerFrame fixed steps
+        RunnerStats run(std::size_t frames, std::size_t stepsPerFrame = 16);
+
+        std::size_t size() const noexcept { return _worlds.size(); }
+        World& world(std::size_t index) noexcept { return *_worlds[index]; }
+    };
+}